@@ -15,8 +15,17 @@ public:
 
     // 重写或新增适合圆形迷宫的方法
     void generate() override;
-    std::vector<Point> getAccessibleNeighbors(const Point& p) const override;
+    using Maze::getAccessibleNeighbors;
+    void getAccessibleNeighbors(const Point& p, NeighborList& out) const override;
     bool isValidPosition(const Point& p) const override;
+    
+    // 稠密编号：按环依次排列，第r环的格子从ring_offsets[r]开始
+    int getCellCount() const override;
+    int toIndex(const Point& p) const override;
+    Point fromIndex(int index) const override;
+    int getNeighborIndices(int index, int* out) const override;
+    int getDistanceLowerBound(int from, int to) const override;
+    bool isRectangularGrid() const override { return false; }
 
     int getRings() const { return rings; }
     int getCellsInRing(int ring) const;
@@ -24,6 +33,7 @@ public:
 private:
     int rings;
     std::vector<int> cells_in_ring;
+    std::vector<int> ring_offsets;   // 每一环第一个格子的稠密编号，末尾为格子总数
     // 使用一种方式来存储墙壁，例如：
     // 0: clockwise, 1: outward
     std::vector<std::vector<bool>> horizontal_walls; // "水平"墙 (同心圆)
@@ -0,0 +1,107 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "maze.h"
+#include "pathfinder.h"
+#include "visualizer.h"
+#include "mondrian_maze.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <iosfwd>
+#include <cstdint>
+
+/**
+ * 一个批处理作业：迷宫类型和规模、生成算法、种子、求解算法列表、导出格式和输出路径
+ * 文本形式是若干 key=value（命令行参数也可以写成 --key value），例如：
+ *   type=rect rows=200 cols=300 generator=kruskal seed=7 solvers=bfs,astar export=html output=out_{n}.html
+ * output中的{n}替换为作业编号，{seed}替换为实际使用的种子
+ */
+struct JobSpec {
+    std::string type = "rect";          // rect / circular / mondrian
+    int rows = 20;
+    int cols = 20;
+    int rings = 8;                      // 圆形迷宫的环数
+    std::string generator = "dfs";      // dfs / kruskal / eller / parallel / random
+    double wallRemoval = 0.6;           // generator=random时的拆墙概率
+    std::uint64_t seed = 0;             // 0表示随机选取
+    std::vector<std::string> solvers;   // bfs dfs astar bibfs biastar jps tree pbfs，all表示全部
+    std::string exportFormat;           // 空 / text / html / maze
+    std::string output;                 // 导出文件路径
+    int repeat = 1;                     // 重复次数，第i次使用种子seed+i
+
+    // 设置一个字段；键或值无效时返回false并给出原因
+    bool set(const std::string& key, const std::string& value, std::string& error);
+    // 解析一行 key=value（#之后为注释）；空行返回true且empty为true
+    bool parseLine(const std::string& line, bool& empty, std::string& error);
+    // 解析命令行参数（--key value 或 key=value）
+    bool parseArguments(const std::vector<std::string>& args, std::string& error);
+    // 检查字段之间的约束（矩形迷宫的格子数不能超过INT_MAX），各字段单独由set检查
+    bool validate(std::string& error) const;
+};
+
+// 一个求解算法在作业中的统计
+struct SolverStats {
+    std::string name;
+    bool found = false;
+    int steps = 0;
+    int visitedNodes = 0;
+    double searchTime = 0.0;    // 毫秒
+};
+
+// 一个作业的执行结果；error非空表示失败
+struct JobResult {
+    std::uint64_t seed = 0;
+    int rooms = 0;              // 蒙德里安迷宫的房间数
+    double generateTime = 0.0;  // 毫秒，命中缓存时为0
+    bool cached = false;        // 迷宫与上一个作业相同，没有重新生成
+    std::vector<SolverStats> solvers;
+    std::string exportPath;
+    std::string error;
+};
+
+/**
+ * 批处理执行器 - 不经过菜单，在同一个进程里连续执行作业
+ * 功能：
+ * 1. 每个作业输出一行 key=value 的结果（生成耗时，以及每个求解算法的步数、访问数、耗时）
+ * 2. PathFinder的缓冲区和矩形迷宫的存储在作业之间复用：规模相同的作业直接在原迷宫上重新生成
+ * 3. 迷宫参数和种子与上一个作业完全相同时跳过生成，直接在已有的迷宫上求解和导出
+ * 4. 作业失败只输出一行 error=...，不影响后面的作业
+ * 一个执行器同一时刻只能执行一个作业；多线程时每个线程使用自己的执行器（见JobServer）
+ */
+class BatchRunner {
+public:
+    BatchRunner();
+
+    // 执行一个作业（包括repeat次重复），结果写入out，返回是否全部成功
+    bool run(const JobSpec& spec, std::ostream& out);
+    // 逐行读取作业文件并执行，返回失败的作业数
+    int runJobFile(std::istream& in, std::ostream& out);
+    // 用给定的种子执行一次作业（忽略repeat），不输出；
+    // jobNumber为输出路径中{n}的取值，0表示使用本执行器的作业计数（多个执行器并行时由调用者统一编号）
+    bool execute(const JobSpec& spec, std::uint64_t seed, JobResult& result, int jobNumber = 0);
+
+    // 把结果写成一行 key=value
+    static void writeLine(const JobSpec& spec, int job, const JobResult& result, std::ostream& out);
+
+    int getJobCount() const { return jobCount; }
+
+private:
+    PathFinder pathFinder;
+    Visualizer visualizer;
+    std::unique_ptr<Maze> maze;              // 上一个矩形或圆形迷宫
+    std::unique_ptr<MondrianMaze> mondrian;  // 上一个蒙德里安迷宫
+    std::string mazeKey;                     // 上一个迷宫的参数和种子，用于判断能否直接复用
+    int jobCount = 0;
+
+    bool executeMondrian(const JobSpec& spec, std::uint64_t seed, const std::string& output, JobResult& result);
+    Maze& prepareMaze(const JobSpec& spec);
+    bool generate(Maze& target, const JobSpec& spec, std::uint64_t seed, std::string& error);
+    bool solve(Maze& target, const std::string& solver, PathFinder::SearchResult& result);
+    bool exportMaze(const Maze& target, const JobSpec& spec, const std::vector<Point>& path,
+                    const std::string& output, std::string& error);
+    static std::string expandOutput(const std::string& pattern, int jobNumber, std::uint64_t seed);
+    static std::string makeKey(const JobSpec& spec, std::uint64_t seed);
+};
+
+#endif // BATCH_RUNNER_H
@@ -0,0 +1,49 @@
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+#include <vector>
+#include <numeric>
+#include <utility>
+
+/**
+ * 并查集 - 平铺在一个数组上的不相交集合
+ * 功能：
+ * 1. 元素是 [0, n) 内的整数编号（如格子编号），父指针和集合大小各占一个int
+ * 2. find使用路径减半，unite按大小合并，均摊接近常数
+ * 3. reset(n)复用已分配的缓冲区
+ */
+class DisjointSet {
+public:
+    void reset(int n) {
+        parent.resize(n);
+        std::iota(parent.begin(), parent.end(), 0);
+        size.assign(n, 1);
+    }
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // 合并a、b所在的集合；两者原本就在同一集合时返回false
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+
+    std::size_t memoryBytes() const { return (parent.capacity() + size.capacity()) * sizeof(int); }
+
+private:
+    std::vector<int> parent;
+    std::vector<int> size;
+};
+
+#endif // DISJOINT_SET_H
@@ -0,0 +1,56 @@
+#ifndef ELLER_GENERATOR_H
+#define ELLER_GENERATOR_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "random.h"
+#include <iosfwd>
+
+/**
+ * Eller算法逐行生成器 - 只保存一行状态的完美迷宫生成
+ * 功能：
+ * 1. 每行记录每个格子所属的集合编号（行首压缩到 [0, cols)），集合之间的关系只在本行内用并查集维护
+ * 2. 行内随机拆除相邻不同集合之间的右墙；每个集合至少向下打通一格，保证后续仍能连通
+ * 3. 最后一行把所有不同集合连起来，得到一棵生成树（完美迷宫）
+ * 4. 输出的墙壁位与MazeStorage的行布局相同（每行wordsPerRow个64位字，1为墙，行尾填充位为1），
+ *    可以直接写入Maze的存储，也可以逐行写到文件：内存只与列数有关，与行数无关
+ */
+class EllerGenerator {
+public:
+    EllerGenerator(int cols, std::uint64_t seed);
+
+    int getCols() const { return cols; }
+    std::size_t getWordsPerRow() const { return wordsPerRow; }
+    // 已经生成的行数
+    long long getRowsGenerated() const { return rowsGenerated; }
+
+    // 生成下一行：rightWalls、bottomWalls各写入wordsPerRow个字。
+    // lastRow为true时连通所有剩余集合，下墙全部保留（迷宫的下边界）
+    void nextRow(std::uint64_t* rightWalls, std::uint64_t* bottomWalls, bool lastRow);
+
+    // 逐行生成rows × cols的迷宫并以文本形式（+--+ 画法，入口左上角S、出口右下角E）写入out，
+    // 整个过程只保存当前一行；返回写入的行数
+    static long long writeText(std::ostream& out, long long rows, int cols, std::uint64_t seed);
+
+    // 生成器自身占用的字节数
+    std::size_t memoryBytes() const;
+
+private:
+    int cols;
+    std::size_t wordsPerRow;
+    long long rowsGenerated = 0;
+    int labelCount = 0;          // 当前行首已经使用的集合编号个数
+    Xoshiro256 rng;
+    RandomBits coins;            // 拆墙与否的硬币，每次取64位逐位使用
+    std::vector<int> setOf;      // 当前行每格的集合编号，-1表示上一行没有向下打通、需要新编号
+    std::vector<int> parent;     // 本行集合编号上的并查集
+    std::vector<int> remap;      // 下一行开始时把集合编号压缩到 [0, cols)
+    std::vector<int> members;    // 尚未向下打通的集合中已经遇到的格子数（蓄水池抽样）
+    std::vector<int> chosen;     // 上述集合中被抽中向下打通的格子
+    std::vector<char> opened;    // 集合是否已经向下打通
+
+    int find(int label);
+};
+
+#endif // ELLER_GENERATOR_H
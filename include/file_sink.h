@@ -0,0 +1,45 @@
+#ifndef FILE_SINK_H
+#define FILE_SINK_H
+
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * 带大缓冲区的输出文件 - 供导出器按行流式写入
+ * 功能：
+ * 1. 是一个std::streambuf，可以直接套上std::ostream使用；写满固定大小的缓冲区（默认1MB）才调用一次write()
+ * 2. 写入比缓冲区还大的数据块时，用writev把缓冲区中已有的内容和数据块一次写出，不再复制
+ * 3. 只使用自己的文件描述符和缓冲区，不涉及std::cout，多个线程可以同时导出到不同的文件
+ * 4. 写入出错后丢弃后续数据，close()返回是否全部写入成功；析构时自动close
+ */
+class FileSink : public std::streambuf {
+public:
+    explicit FileSink(const std::string& filename, std::size_t bufferSize = 1 << 20);
+    ~FileSink() override;
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    bool isOpen() const { return fd >= 0; }
+    bool good() const { return fd >= 0 && !failed; }
+
+    // 写出缓冲区中剩余的数据并关闭文件
+    bool close();
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* data, std::streamsize length) override;
+    int sync() override;
+
+private:
+    int fd;
+    bool failed = false;
+    std::vector<char> buffer;
+
+    // 把缓冲区中的内容和extra（可以为空）一起写出，清空缓冲区
+    bool drain(const char* extra = nullptr, std::size_t extraLength = 0);
+};
+
+#endif // FILE_SINK_H
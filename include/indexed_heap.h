@@ -0,0 +1,99 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * 带索引的二叉最小堆 - 支持decrease-key的优先队列
+ * 功能：
+ * 1. 元素是 [0, n) 内的整数编号（如格子编号），每个编号在堆中至多出现一次
+ * 2. pos数组记录每个编号在堆中的位置，改小键值时原地上浮，不会产生重复元素
+ * 3. clear()只重置堆中剩余元素的位置，缓冲区保留给下一次搜索复用
+ */
+class IndexedHeap {
+public:
+    // 保证可以容纳编号 [0, n)
+    void reserveIds(int n) {
+        if (static_cast<int>(pos.size()) < n) pos.resize(n, -1);
+    }
+
+    bool empty() const { return heap.empty(); }
+    int size() const { return static_cast<int>(heap.size()); }
+    bool contains(int id) const { return pos[id] >= 0; }
+    std::int64_t keyOf(int id) const { return heap[pos[id]].key; }
+    std::int64_t topKey() const { return heap[0].key; }
+
+    // 插入新元素，或在新键值更小时执行decrease-key
+    void pushOrDecrease(int id, std::int64_t key) {
+        int i = pos[id];
+        if (i < 0) {
+            i = static_cast<int>(heap.size());
+            heap.push_back(Entry{key, id});
+            pos[id] = i;
+        } else if (key < heap[i].key) {
+            heap[i].key = key;
+        } else {
+            return;
+        }
+        siftUp(i);
+    }
+
+    // 弹出键值最小的元素
+    int pop() {
+        int top = heap[0].id;
+        pos[top] = -1;
+        Entry last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            pos[last.id] = 0;
+            siftDown(0);
+        }
+        return top;
+    }
+
+    void clear() {
+        for (const Entry& e : heap) pos[e.id] = -1;
+        heap.clear();
+    }
+
+private:
+    struct Entry {
+        std::int64_t key;
+        int id;
+    };
+    std::vector<Entry> heap;
+    std::vector<int> pos;  // 编号在heap中的下标，不在堆中为-1
+
+    void siftUp(int i) {
+        Entry e = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (heap[parent].key <= e.key) break;
+            heap[i] = heap[parent];
+            pos[heap[i].id] = i;
+            i = parent;
+        }
+        heap[i] = e;
+        pos[e.id] = i;
+    }
+
+    void siftDown(int i) {
+        Entry e = heap[i];
+        int n = static_cast<int>(heap.size());
+        while (true) {
+            int child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && heap[child + 1].key < heap[child].key) child++;
+            if (e.key <= heap[child].key) break;
+            heap[i] = heap[child];
+            pos[heap[i].id] = i;
+            i = child;
+        }
+        heap[i] = e;
+        pos[e.id] = i;
+    }
+};
+
+#endif // INDEXED_HEAP_H
@@ -0,0 +1,61 @@
+#ifndef JOB_SERVER_H
+#define JOB_SERVER_H
+
+#include "batch_runner.h"
+#include "thread_pool.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <iosfwd>
+
+/**
+ * 作业服务器 - 常驻进程，从标准输入或本地Unix套接字读取每行一个JSON对象的作业
+ * 功能：
+ * 1. 作业字段与批处理的key=value相同，另有id（原样回显）和op：
+ *    generate只生成，solve生成并求解（默认bfs），compare运行多个算法并给出最快的（默认全部），export生成并导出
+ * 2. 作业分派给固定数量的工作线程，每个线程拥有自己的BatchRunner（PathFinder缓冲区和上一个迷宫）
+ * 3. 结果按完成顺序逐行写回（JSON，带id），不保证与请求顺序相同
+ * 4. 每个输入流最多同时有固定数量的作业在执行，读得太快时暂停读取
+ * 5. output中的{n}是全服务器统一的作业编号（按接收顺序），不同线程上的作业不会写到同一个文件
+ * 例：{"id":1,"op":"compare","type":"rect","size":"200x200","seed":7}
+ */
+class JobServer {
+public:
+    // threadCount为0时使用硬件线程数
+    explicit JobServer(int threadCount = 0);
+
+    // 处理in中的全部作业并等待完成，结果写入out；返回失败的作业数
+    int serveStream(std::istream& in, std::ostream& out);
+    // 在path上监听Unix套接字，每个连接独立读写，直到出错才返回
+    bool serveSocket(const std::string& path);
+
+    int getThreadCount() const { return pool.size() - 1; }
+
+private:
+    ThreadPool pool;
+    std::vector<std::unique_ptr<BatchRunner>> runners;    // 按工作线程编号索引
+    int maxInFlight;
+    std::atomic<int> jobCounter{0};  // 已接收的作业数，用作作业编号
+
+    struct Channel;
+
+    struct Request {
+        std::string id;     // id的JSON文本，没有id时为null
+        std::string op;
+        JobSpec spec;
+        int number = 0;     // 分派时取得的作业编号
+    };
+
+    // 解析一行作业；返回false时error给出原因（id尽量解析出来以便回显）
+    static bool parseRequest(const std::string& line, Request& request, std::string& error);
+    // 在当前工作线程上执行作业，返回一行JSON结果（含结尾换行）
+    std::string execute(const Request& request, bool& ok);
+    static std::string errorLine(const std::string& id, const std::string& error);
+    // 解析一行作业并提交给线程池，同一个输入流的在途作业数达到上限时阻塞
+    void dispatch(const std::shared_ptr<Channel>& channel, const std::string& line);
+    // 处理一个套接字连接，读到结尾并写完全部结果后关闭
+    void serveConnection(int fd);
+};
+
+#endif // JOB_SERVER_H
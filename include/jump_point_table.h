@@ -0,0 +1,39 @@
+#ifndef JUMP_POINT_TABLE_H
+#define JUMP_POINT_TABLE_H
+
+#include <vector>
+#include <cstdint>
+
+class Maze;
+
+/**
+ * 跳点表 - 4连通JPS+的预计算跳跃距离
+ * 规范路径：同样长度的最短路径中，水平移动尽可能靠前。因此
+ * 1. 竖直移动后只继续竖直前进；只有"先水平再竖直"的绕行被墙挡住时，
+ *    才允许转向水平方向（强迫邻居）
+ * 2. 水平移动后可以继续水平前进，也可以转向上下两个竖直方向
+ * 表中每个格子每个方向保存一个值（方向顺序同WallDirection）：
+ * - 大于0：沿该方向前进这么多步到达跳点
+ *   （竖直方向：有强迫邻居的格子；水平方向：向上或向下的竖直跳跃能找到跳点的格子）
+ * - 小于等于0：沿该方向没有跳点，取反后是撞墙前能前进的步数
+ * 表只与墙壁有关，与终点无关；终点在查询时单独判断
+ */
+class JumpPointTable {
+public:
+    explicit JumpPointTable(const Maze& maze);
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    // 格子index沿方向dir（0~3，同WallDirection）的跳跃值
+    int jump(int index, int dir) const { return table[static_cast<std::size_t>(index) * 4 + dir]; }
+
+    // 占用的字节数
+    std::size_t memoryBytes() const { return table.size() * sizeof(std::int32_t); }
+
+private:
+    int rows, cols;
+    std::vector<std::int32_t> table;   // 每格4个值
+};
+
+#endif // JUMP_POINT_TABLE_H
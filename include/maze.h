@@ -4,7 +4,14 @@
 #include <vector>
 #include <iostream>
 #include <random>
+#include "random.h"
 #include <queue>
+#include <memory>
+#include "maze_storage.h"
+
+class JumpPointTable;
+class TreeIndex;
+class MazeFile;
 
 /**
  * 迷宫类 - 使用线段表示墙壁的迷宫系统
@@ -31,6 +38,13 @@ enum class CellType {
     VISITED = 3    // 已访问（用于路径标记）
 };
 
+// 完美迷宫的生成算法（generate()按此选择）
+enum class GenerationAlgorithm {
+    DFS = 0,       // 随机深度优先（长走廊、分支少）
+    KRUSKAL = 1,   // 随机Kruskal（并查集，分支多、死胡同短）
+    ELLER = 2      // Eller逐行生成（只保存一行状态）
+};
+
 // 坐标结构
 struct Point {
     int x, y;
@@ -47,7 +61,25 @@ struct Point {
     }
 };
 
+// 定长邻居列表 - 邻居数量有上限，直接存放在栈上，查询时不分配堆内存
+// 矩形格子最多4个邻居，圆形迷宫最多5个（顺/逆时针、两个外环、一个内环）
+struct NeighborList {
+    static constexpr int CAPACITY = 6;
+    Point items[CAPACITY];
+    int count;
+    
+    NeighborList() : count(0) {}
+    void clear() { count = 0; }
+    void push(const Point& p) { items[count++] = p; }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Point& operator[](int i) const { return items[i]; }
+    const Point* begin() const { return items; }
+    const Point* end() const { return items + count; }
+};
+
 // 迷宫格子结构体 - 使用线段表示墙壁
+// 迷宫内部以紧凑位平面存储，getCell返回的是该格子四面墙和类型的快照
 struct MazeCell {
     bool walls[4];  // 四个方向的墙：上、右、下、左
     CellType type;  // 格子类型
@@ -78,13 +110,34 @@ struct MazeCell {
 class Maze {
 private:
     int rows, cols;                              // 迷宫的行数和列数
-    std::vector<std::vector<MazeCell>> grid;     // 迷宫矩阵（使用线段墙壁）
+    MazeStorage storage;                         // 紧凑墙壁位平面和格子类型平面
     Point entrance, exit;                        // 入口和出口坐标
-    std::mt19937 rng;                           // 随机数生成器
+    std::uint64_t seed;                          // 随机数生成器最近一次使用的种子
+    Xoshiro256 rng;                              // 随机数生成器（所有生成算法共用）
+    GenerationAlgorithm generationAlgorithm = GenerationAlgorithm::DFS;  // generate()使用的算法
+    mutable std::shared_ptr<const JumpPointTable> jumpTable;  // 按需构建的跳点表，墙壁改变时作废
+    mutable std::shared_ptr<const TreeIndex> treeIndex;       // 按需构建的树索引，墙壁改变时作废
 
     // 获取相邻格子的坐标和对应的墙方向
     Point getAdjacentCell(const Point& p, WallDirection dir) const;
     WallDirection getOppositeDirection(WallDirection dir) const;
+    
+    // 由已经填好的存储构造（迷宫文件读入或映射时使用）
+    Maze(MazeStorage&& storage, const Point& entrance, const Point& exit);
+    friend class MazeFile;
+
+    // 坐标是否落在存储网格内（与虚函数isValidPosition无关）
+    bool inGrid(int x, int y) const { return x >= 0 && x < rows && y >= 0 && y < cols; }
+
+protected:
+    // 派生类的生成算法也使用同一个生成器，保证同一种子生成同一个迷宫
+    Xoshiro256& getRng() { return rng; }
+
+    // 墙壁改变后作废由墙壁推导出的缓存（派生类自己保存墙壁时也要调用）
+    void wallsChanged() {
+        if (jumpTable) jumpTable.reset();
+        if (treeIndex) treeIndex.reset();
+    }
 
 public:
     // 构造函数
@@ -98,8 +151,9 @@ public:
     int getCols() const { return cols; }
     
     // 格子操作
-    const MazeCell& getCell(int x, int y) const;
-    const MazeCell& getCell(const Point& p) const { return getCell(p.x, p.y); }
+    MazeCell getCell(int x, int y) const;
+    MazeCell getCell(const Point& p) const { return getCell(p.x, p.y); }
+    CellType getCellType(int x, int y) const;
     void setCellType(int x, int y, CellType type);
     void setCellType(const Point& p, CellType type) { setCellType(p.x, p.y, type); }
     
@@ -124,13 +178,44 @@ public:
     void generateRandomMaze(double wallRemovalProbability = 0.6); // 恢复此函数
     void generateWithDFS();
     void generatePerfectMaze();
+    // 随机Kruskal：打乱所有内墙，用平铺的并查集拆掉连接两个不同集合的墙
+    void generateWithKruskal();
+    // Eller算法：逐行生成，只需要一行的集合状态（见EllerGenerator）
+    void generateWithEller();
+    // 并行分块生成完美迷宫：各块在线程池中用随机Kruskal并行生成，再在块之间连出一棵生成树。
+    // 结果只由seed决定（与线程数无关，seed同时成为迷宫的种子）；threadCount为0时使用全部硬件线程
+    void generateParallel(std::uint64_t seed, int threadCount = 0);
     virtual void generate(); // 新增的虚函数，用于多态生成
+    void setGenerationAlgorithm(GenerationAlgorithm algorithm) { generationAlgorithm = algorithm; }
+    // 设置随机种子并重置生成器：之后的生成结果只由种子和生成算法决定。
+    // 构造时种子取自random_device，可用getSeed()记录下来复现
+    void setSeed(std::uint64_t newSeed) { seed = newSeed; rng.reseed(newSeed); }
+    std::uint64_t getSeed() const { return seed; }
+    GenerationAlgorithm getGenerationAlgorithm() const { return generationAlgorithm; }
     void loadFromWallArray(const std::vector<std::vector<std::vector<bool>>>& wallData);
     
     // 实用函数
     virtual bool isValidPosition(const Point& p) const; // 改为虚函数
     bool canMoveTo(const Point& from, const Point& to) const;  // 检查两个相邻格子间是否可通行
     virtual std::vector<Point> getAccessibleNeighbors(const Point& p) const; // 改为虚函数
+    virtual void getAccessibleNeighbors(const Point& p, NeighborList& out) const; // 不分配内存的版本
+    // 开放方向掩码：第d位为1表示可以向WallDirection(d)方向移动到相邻格子
+    inline unsigned getOpenDirections(int x, int y) const;
+    
+    // 稠密格子编号：每个格子对应 [0, getCellCount()) 内唯一的整数，供平铺数组使用
+    virtual int getCellCount() const;
+    // 格子编号用int表示：rows*cols超过INT_MAX的尺寸不能构造，读入或生成前先用它检查
+    static bool isSupportedSize(long long rows, long long cols);
+    virtual int toIndex(const Point& p) const;
+    virtual Point fromIndex(int index) const;
+    // 按编号获取可通行邻居，写入out（容量至少NeighborList::CAPACITY），返回邻居个数
+    virtual int getNeighborIndices(int index, int* out) const;
+    // 矩形网格的邻居编号（内联、非虚函数，供已知是矩形网格的热循环使用）
+    inline int getGridNeighborIndices(int index, int* out) const;
+    // 两个格子间最短路径长度的下界（A*的启发式函数，要求满足一致性）
+    virtual int getDistanceLowerBound(int from, int to) const;
+    // 是否为普通矩形网格（派生的非矩形迷宫返回false）
+    virtual bool isRectangularGrid() const { return true; }
     std::vector<Point> getAllNeighbors(const Point& p) const;         // 获取所有邻居（不考虑墙壁）
     
     // 重置迷宫状态（清除访问标记）
@@ -148,6 +233,42 @@ public:
     int countWalls() const;
     int countOpenPaths() const;
     double getConnectivity() const;  // 计算迷宫连通性
+    bool isExitReachable() const;    // 从入口能否到达出口（位行泛洪填充，不做路径搜索）
+    
+    // 底层存储（供按行扫描的算法直接读取墙壁位）
+    const MazeStorage& getStorage() const { return storage; }
+    
+    // JPS+跳点表：第一次调用时构建并缓存，之后修改墙壁会使缓存失效
+    std::shared_ptr<const JumpPointTable> getJumpPointTable() const;
+    
+    // 完美迷宫的树索引：第一次调用时构建并缓存；迷宫不是树时返回的索引isTree()为false
+    std::shared_ptr<const TreeIndex> getTreeIndex() const;
 };
 
+inline unsigned Maze::getOpenDirections(int x, int y) const {
+    if (!inGrid(x, y)) return 0;
+    
+    // 直接读取共享墙壁位，只保留通向网格内格子的方向
+    unsigned open = 0;
+    if (x > 0 && !storage.bottomWall(x - 1, y))       open |= 1u << static_cast<int>(WallDirection::TOP);
+    if (y < cols - 1 && !storage.rightWall(x, y))     open |= 1u << static_cast<int>(WallDirection::RIGHT);
+    if (x < rows - 1 && !storage.bottomWall(x, y))    open |= 1u << static_cast<int>(WallDirection::BOTTOM);
+    if (y > 0 && !storage.rightWall(x, y - 1))        open |= 1u << static_cast<int>(WallDirection::LEFT);
+    return open;
+}
+
+inline int Maze::getGridNeighborIndices(int index, int* out) const {
+    int x = index / cols;
+    int y = index - x * cols;
+    unsigned open = getOpenDirections(x, y);
+    
+    // 顺序与getAccessibleNeighbors相同：上、右、下、左
+    int count = 0;
+    if (open & (1u << static_cast<int>(WallDirection::TOP)))    out[count++] = index - cols;
+    if (open & (1u << static_cast<int>(WallDirection::RIGHT)))  out[count++] = index + 1;
+    if (open & (1u << static_cast<int>(WallDirection::BOTTOM))) out[count++] = index + cols;
+    if (open & (1u << static_cast<int>(WallDirection::LEFT)))   out[count++] = index - 1;
+    return count;
+}
+
 #endif // MAZE_H
@@ -0,0 +1,60 @@
+#ifndef MAZE_FILE_H
+#define MAZE_FILE_H
+
+#include <string>
+#include <memory>
+#include <cstdint>
+#include "maze.h"
+
+/**
+ * 二进制迷宫文件 - 头部 + MazeStorage的两个平面原样存放
+ * 布局（小端）：
+ * 1. 64字节头部：魔数"MAZEBIN\0"、版本、头部大小、行列数、入口/出口、随机种子、生成算法、
+ *    墙壁位平面的字数
+ * 2. 紧接着是墙壁位平面（wordCount个64位字，按MazeStorage的行布局，偏移64保证8字节对齐）
+ * 3. 最后是格子类型平面（每格2位）
+ * 功能：
+ * 1. save/load：整块写出和读入
+ * 2. map：用mmap把文件映射为迷宫的存储，不复制数据，打开多GB的迷宫也几乎不耗时；
+ *    映射是私有的（写时复制），求解时修改格子类型不会写回文件
+ * 3. writeEller：用EllerGenerator逐行生成并直接写入文件，内存只与列数有关
+ * 失败时在std::cerr输出原因，save/writeEller返回false，load/map返回空指针
+ */
+class MazeFile {
+public:
+    static const std::uint32_t VERSION = 1;
+    static const std::uint32_t HEADER_SIZE = 64;
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::int32_t rows, cols;
+        std::int32_t entranceX, entranceY;
+        std::int32_t exitX, exitY;
+        std::uint64_t seed;           // 生成时使用的随机种子（未知为0）
+        std::uint32_t generator;      // GenerationAlgorithm
+        std::uint32_t reserved;
+        std::uint64_t wallWords;      // 墙壁位平面的64位字数
+    };
+
+    // 写出迷宫（只支持矩形迷宫）；迷宫的随机种子和生成算法记录在头部
+    // quiet为true时出错只返回false，不写std::cerr（批处理和服务器的工作线程使用）
+    static bool save(const Maze& maze, const std::string& filename, bool quiet = false);
+    // 读入到自己分配的内存中
+    static std::unique_ptr<Maze> load(const std::string& filename);
+    // 内存映射打开，迷宫的存储直接指向映射的文件内容
+    static std::unique_ptr<Maze> map(const std::string& filename);
+    // 只读取并校验头部
+    static bool readHeader(const std::string& filename, Header& header);
+
+    // 用Eller算法逐行生成rows × cols的完美迷宫，直接写入filename（入口左上角、出口右下角）
+    static bool writeEller(const std::string& filename, int rows, int cols, std::uint64_t seed);
+
+private:
+    static Header makeHeader(int rows, int cols, const Point& entrance, const Point& exit,
+                             std::uint64_t seed, GenerationAlgorithm generator);
+    static bool validate(const Header& header, std::uint64_t fileSize, const std::string& filename);
+};
+
+#endif // MAZE_FILE_H
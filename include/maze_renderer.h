@@ -0,0 +1,86 @@
+#ifndef MAZE_RENDERER_H
+#define MAZE_RENDERER_H
+
+#include "maze.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iosfwd>
+
+/**
+ * 终端迷宫渲染器 - 把矩形迷宫画进一块可复用的UTF-8帧缓冲区
+ * 功能：
+ * 1. 直接按行读取墙壁位平面和格子类型平面，每个交叉点的连接符查16项的表得到
+ * 2. 两种样式：LABELED与Visualizer的线段墙壁显示相同（带行列号、可选颜色），PLAIN与Maze::printMaze相同
+ * 3. 路径以叠加层的方式画出，不需要复制迷宫
+ * 4. present把整帧一次写出：输出到控制台时是一次write()，其他流（文件、重定向）是一次stream写入；
+ *    stream不保留整帧，每画完一行就写出去，导出大迷宫时内存只与列数和路径长度有关
+ * 5. 增量动画（LABELED样式）：整帧只画一次，之后每个显示周期只用ANSI光标定位重画变化的格子
+ * 只支持矩形网格（isRectangularGrid），其他形状仍由调用者逐格绘制
+ */
+class MazeRenderer {
+public:
+    enum class Style {
+        LABELED,    // 行列号 + 线段墙壁（Visualizer::displayMaze）
+        PLAIN       // 只有线段墙壁（Maze::printMaze）
+    };
+
+    explicit MazeRenderer(Style style = Style::LABELED, bool useColors = false);
+
+    void setUseColors(bool colors);
+
+    static bool supports(const Maze& maze) {
+        return maze.isRectangularGrid() && maze.getRows() > 0 && maze.getCols() > 0;
+    }
+
+    // 画一帧（覆盖上一帧）；path中除入口和出口以外的格子画成已访问
+    void render(const Maze& maze, const std::vector<Point>& path = std::vector<Point>());
+    const char* frameData() const { return frame.data(); }
+    std::size_t frameSize() const { return frameLength; }
+
+    // 输出当前帧
+    void present(std::ostream& out) const;
+    
+    // 与render + present的输出相同，但逐行写到out，缓冲区只容纳一行；之后frameData为空
+    void stream(const Maze& maze, const std::vector<Point>& path, std::ostream& out);
+
+    // 增量动画：render之后调用beginAnimation，清屏并从第2行起画出当前帧（第1行留给status），
+    // 只画能放进screenLines×screenColumns终端的部分并关闭自动换行；之后每次renderPatch生成
+    // 只包含status和cells中各格子（重画成type）的光标定位序列，屏幕外的格子跳过；endAnimation把光标移到帧下方
+    // 这三个函数的结果都由presentPatch输出
+    void beginAnimation(const std::string& status, int screenLines, int screenColumns);
+    void renderPatch(const std::string& status, const Point* cells, std::size_t count, CellType type);
+    void endAnimation();
+    void presentPatch(std::ostream& out) const;
+
+private:
+    // 整块复制bytes（定长复制比按长度复制快），再前进length字节；缓冲区末尾留有余量
+    struct Glyph {
+        char bytes[32];
+        int length;
+    };
+
+    Style style;
+    bool useColors;
+    std::vector<char> frame;             // 帧缓冲区，只增不减，在多次绘制之间复用
+    std::size_t frameLength = 0;         // 当前帧的字节数
+    std::vector<std::uint8_t> overlay;   // 路径叠加层，每格1字节，只在有路径时使用
+    std::vector<std::uint8_t> rowMarks;  // stream时当前行的路径标记
+    Glyph junctions[16];                 // 下标：左1 右2 上4 下8，表示交叉点四个方向是否有墙
+    Glyph cells[4];                      // 按CellType索引的格子内容（含颜色）
+    std::string patch;                   // 增量动画的输出（光标定位序列）
+    int animationLastLine = 0;           // 动画中帧在屏幕上可见的最后一行
+    int animationColumns = 0;            // 终端宽度
+
+    void buildCellGlyphs();
+    // 一行（内容行加墙壁行）最多占用的字节数
+    std::size_t rowBound(int cols) const;
+    // 按行画整个迷宫：rowOverlay(i)返回第i行的路径标记（可为空），画完标题和每一行后调用
+    // flush(base, out)，返回之后继续写入的位置；返回结尾位置
+    template <typename RowOverlay, typename Flush>
+    char* draw(const Maze& maze, char* base, RowOverlay rowOverlay, Flush flush) const;
+    static void writeOut(std::ostream& out, const char* data, std::size_t length);
+};
+
+#endif // MAZE_RENDERER_H
@@ -0,0 +1,110 @@
+#ifndef MAZE_STORAGE_H
+#define MAZE_STORAGE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+/**
+ * 紧凑迷宫存储 - 墙壁位平面 + 格子类型平面
+ * 布局：
+ * 1. 每个格子只保存右墙和下墙各1位，相邻格子共享的墙只存一次
+ * 2. 所有墙壁位放在一块连续缓冲区中，按行存放：
+ *    每行先是右墙位（wordsPerRow个64位字），紧接着是下墙位（wordsPerRow个字）
+ * 3. 第0行的上边界和第0列的左边界单独存放在所有行之后
+ * 4. 格子类型每格2位，打包在另一个独立平面中
+ * 位为1表示有墙；行尾的填充位恒为1（视为墙），便于整字扫描
+ * 两个平面可以由自己分配，也可以直接使用外部内存（如内存映射的迷宫文件，见maze_file.h），
+ * 后一种情况不复制数据；复制MazeStorage总是得到一份自己分配的副本
+ */
+class MazeStorage {
+public:
+    MazeStorage(int rows = 0, int cols = 0);
+    MazeStorage(const MazeStorage& other);
+    MazeStorage& operator=(const MazeStorage& other);
+    MazeStorage(MazeStorage&&) noexcept = default;
+    MazeStorage& operator=(MazeStorage&&) noexcept = default;
+
+    // 直接使用外部内存中的两个平面（布局与自己分配时相同，大小见wordCountFor/typeBytesFor）；
+    // owner负责在MazeStorage及其移动目标存活期间保持这块内存有效
+    static MazeStorage adopt(int rows, int cols, std::uint64_t* words, std::uint8_t* types,
+                             std::shared_ptr<void> owner);
+    bool isExternal() const { return owner != nullptr; }
+
+    // 两个平面的大小，以及整块访问（供序列化使用）
+    static std::size_t wordCountFor(int rows, int cols);
+    static std::size_t typeBytesFor(int rows, int cols);
+    std::size_t wordCount() const { return wordCountFor(rows, cols); }
+    std::size_t typeBytes() const { return typeBytesFor(rows, cols); }
+    const std::uint64_t* wordData() const { return wordBits; }
+    const std::uint8_t* typeData() const { return typeBits; }
+    std::uint64_t* wordData() { return wordBits; }
+    std::uint8_t* typeData() { return typeBits; }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    std::size_t getWordsPerRow() const { return wordsPerRow; }
+
+    // 恢复为所有墙都存在、所有格子类型为0的初始状态
+    void reset();
+
+    // 单个墙壁位的读写（调用者保证坐标在范围内）
+    bool rightWall(int x, int y) const { return testBit(rightRow(x), y); }
+    bool bottomWall(int x, int y) const { return testBit(bottomRow(x), y); }
+    bool topBorder(int y) const { return testBit(topBorderBits(), y); }
+    bool leftBorder(int x) const { return testBit(leftBorderBits(), x); }
+    void setRightWall(int x, int y, bool wall) { assignBit(rightRow(x), y, wall); }
+    void setBottomWall(int x, int y, bool wall) { assignBit(bottomRow(x), y, wall); }
+    void setTopBorder(int y, bool wall) { assignBit(topBorderBits(), y, wall); }
+    void setLeftBorder(int x, bool wall) { assignBit(leftBorderBits(), x, wall); }
+
+    // 整行访问（供按行扫描的算法使用）
+    const std::uint64_t* rightRow(int x) const { return wordBits + rowOffset(x); }
+    const std::uint64_t* bottomRow(int x) const { return wordBits + rowOffset(x) + wordsPerRow; }
+    std::uint64_t* rightRow(int x) { return wordBits + rowOffset(x); }
+    std::uint64_t* bottomRow(int x) { return wordBits + rowOffset(x) + wordsPerRow; }
+
+    // 格子类型（2位编码）
+    std::uint8_t cellType(int x, int y) const {
+        std::size_t i = cellOffset(x, y);
+        return (typeBits[i >> 2] >> ((i & 3) * 2)) & 3;
+    }
+    void setCellType(int x, int y, std::uint8_t type) {
+        std::size_t i = cellOffset(x, y);
+        unsigned shift = (i & 3) * 2;
+        typeBits[i >> 2] = static_cast<std::uint8_t>((typeBits[i >> 2] & ~(3u << shift)) | ((type & 3u) << shift));
+    }
+
+    // 统计
+    std::size_t countInteriorWalls() const;  // 内部墙壁数（相邻格子之间）
+    std::size_t countBorderWalls() const;    // 外围边界墙壁数
+    std::size_t memoryBytes() const;         // 存储占用的字节数
+
+private:
+    int rows, cols;
+    std::size_t wordsPerRow;               // 每个位平面一行占用的64位字数
+    std::vector<std::uint64_t> words;      // 自己分配的墙壁位：rows × [右墙 | 下墙]，随后是上边界和左边界
+    std::vector<std::uint8_t> types;       // 自己分配的格子类型，每格2位
+    std::uint64_t* wordBits = nullptr;     // 正在使用的墙壁位（指向words或外部内存）
+    std::uint8_t* typeBits = nullptr;      // 正在使用的格子类型
+    std::shared_ptr<void> owner;           // 外部内存的所有者；自己分配时为空
+
+    std::size_t rowOffset(int x) const { return static_cast<std::size_t>(x) * 2 * wordsPerRow; }
+    std::size_t cellOffset(int x, int y) const { return static_cast<std::size_t>(x) * cols + y; }
+    const std::uint64_t* topBorderBits() const { return wordBits + rowOffset(rows); }
+    const std::uint64_t* leftBorderBits() const { return topBorderBits() + wordsPerRow; }
+    std::uint64_t* topBorderBits() { return wordBits + rowOffset(rows); }
+    std::uint64_t* leftBorderBits() { return topBorderBits() + wordsPerRow; }
+
+    static bool testBit(const std::uint64_t* bits, int i) {
+        return (bits[i >> 6] >> (i & 63)) & 1;
+    }
+    static void assignBit(std::uint64_t* bits, int i, bool value) {
+        std::uint64_t mask = std::uint64_t(1) << (i & 63);
+        if (value) bits[i >> 6] |= mask;
+        else bits[i >> 6] &= ~mask;
+    }
+};
+
+#endif // MAZE_STORAGE_H
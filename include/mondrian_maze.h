@@ -3,6 +3,8 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <cstdint>
+#include "random.h"
 
 struct Room {
     int id;
@@ -13,7 +15,9 @@ struct Room {
 
 class MondrianMaze {
 public:
-    MondrianMaze();
+    // 同一个种子生成相同的色块和房间布局
+    explicit MondrianMaze(std::uint64_t seed = Xoshiro256::randomSeed());
+    std::uint64_t getSeed() const { return seed; }
     int getRoomCount() const;
     const Room& getRoom(int id) const;
     const std::vector<Room>& getRooms() const;
@@ -24,6 +28,7 @@ private:
     std::vector<Room> rooms;
     int entranceId;
     int exitId;
+    std::uint64_t seed;
 };
 
 void findAllPathsLimited(const MondrianMaze& maze, int start, int end, int maxPaths, int maxLength, std::vector<std::vector<int>>& allPaths);
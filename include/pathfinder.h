@@ -2,11 +2,18 @@
 #define PATHFINDER_H
 
 #include "maze.h"
+#include "ring_queue.h"
+#include "indexed_heap.h"
+#include "search_trace.h"
 #include <vector>
 #include <queue>
 #include <stack>
 #include <unordered_map>
 #include <algorithm>
+#include <memory>
+#include <cstdint>
+
+class ThreadPool;
 
 /**
  * 路径寻找器类 - 实现多种迷宫路径寻找算法
@@ -14,7 +21,12 @@
  * 1. 深度优先搜索（DFS）寻找路径
  * 2. 广度优先搜索（BFS）寻找最短路径
  * 3. A*算法寻找最优路径
- * 4. 返回路径结果和统计信息
+ * 4. 双向BFS、双向A*从入口和出口同时搜索
+ * 5. 跳点搜索（JPS+）在开阔的矩形迷宫中跳过对称路径
+ * 6. 完美迷宫（生成树）上用树索引直接得到唯一路径
+ * 7. 批量求解多个起点到多个目标的距离矩阵；位并行BFS一次求64个起点到全图的距离
+ * 8. 返回路径结果和统计信息
+ * 9. DFS、BFS和A*可以带一个搜索观察者（search_trace.h），记录扩展顺序等搜索过程
  */
 class PathFinder {
 public:
@@ -29,29 +41,19 @@ public:
         
         SearchResult() : found(false), steps(0), visitedNodes(0), searchTime(0.0) {}
     };
-
-private:
-    // A*算法中的节点结构
-    struct AStarNode {
-        Point point;
-        int gCost;  // 从起点到当前点的实际代价
-        int hCost;  // 从当前点到终点的启发式代价
-        int fCost;  // gCost + hCost
-        AStarNode* parent;
-        
-        AStarNode(const Point& p, int g = 0, int h = 0, AStarNode* par = nullptr)
-            : point(p), gCost(g), hCost(h), fCost(g + h), parent(par) {}
+    
+    // 批量求解结果：sources × targets 的距离矩阵（按行存放，不可达或坐标无效为-1）
+    struct BatchResult {
+        int sourceCount = 0;
+        int targetCount = 0;
+        std::vector<int> distances;
+        std::vector<std::vector<Point>> paths;   // 与distances一一对应；未要求路径时为空
+        int visitedNodes = 0;                    // 所有BFS访问的格子总数
+        double searchTime = 0.0;                 // 总耗时（毫秒）
         
-        bool operator>(const AStarNode& other) const {
-            return fCost > other.fCost;
-        }
-    };
-
-    // 哈希函数用于unordered_map
-    struct PointHash {
-        std::size_t operator()(const Point& p) const {
-            return std::hash<int>()(p.x) ^ (std::hash<int>()(p.y) << 1);
-        }
+        int distance(int source, int target) const { return distances[source * targetCount + target]; }
+        // 离第source个起点最近的目标下标，全部不可达时返回-1
+        int nearestTarget(int source) const;
     };
 
 public:
@@ -67,6 +69,49 @@ public:
     // A*算法
     SearchResult findPathAStar(Maze& maze);
     
+    // 带观察者的DFS、BFS和A*：搜索主循环在发现和扩展格子时回调observer（见search_trace.h），
+    // 不带观察者的版本即observer为NullSearchObserver。模板在pathfinder.cpp中为
+    // NullSearchObserver和SearchTrace显式实例化；传入SearchTrace时会先按迷宫大小reset
+    template <typename Observer>
+    SearchResult findPathDFS(Maze& maze, Observer& observer);
+    template <typename Observer>
+    SearchResult findPathBFS(Maze& maze, Observer& observer);
+    template <typename Observer>
+    SearchResult findPathAStar(Maze& maze, Observer& observer);
+    
+    // 双向BFS：两端按层交替扩展（每次扩展较小的一侧），相遇层结束后拼接最短路径
+    SearchResult findPathBidirectionalBFS(Maze& maze);
+    
+    // 双向A*：两端各自以对方起点为目标做A*，开放列表最小f值不小于已知最短路径时停止
+    SearchResult findPathBidirectionalAStar(Maze& maze);
+    
+    // 跳点搜索（4连通JPS+）：使用迷宫缓存的跳点表，步数与BFS相同；非矩形迷宫退化为A*
+    SearchResult findPathJPS(Maze& maze);
+    
+    // 完美迷宫的树索引查询：使用迷宫缓存的TreeIndex，O(1)求LCA、O(路径长度)输出路径；
+    // 迷宫有环或不连通时退化为BFS
+    SearchResult findPathTree(Maze& maze);
+    
+    // 完美迷宫中任意两格之间的路径长度（O(1)）；迷宫不是树或坐标无效时返回-1
+    static int treeDistance(const Maze& maze, const Point& a, const Point& b);
+    
+    // 批量求解：每个起点到每个目标的最短距离（可选同时返回路径），不修改迷宫的入口和出口。
+    // 从起点和目标中较少的一侧逐个做BFS，所有目标都到达后立即停止
+    BatchResult findDistances(const Maze& maze, const std::vector<Point>& sources,
+                              const std::vector<Point>& targets, bool withPaths = false);
+    
+    // 多起点距离：返回每个起点到所有格子的距离（按稠密格子编号，不可达为-1）。
+    // 默认使用位并行BFS，每64个起点为一组，一次扫描同时推进这64个搜索；
+    // bitParallel为false或起点很少时逐个做普通BFS
+    std::vector<std::vector<int>> multiSourceDistances(const Maze& maze, const std::vector<Point>& sources,
+                                                       bool bitParallel = true);
+    
+    // 方向优化的并行BFS（按层同步，在自顶向下和自底向上扩展之间自动切换）
+    SearchResult findPathParallelBFS(Maze& maze);
+    
+    // 设置并行算法使用的线程数（0表示使用全部硬件线程）
+    void setThreadCount(int threads);
+    
     // 找到所有可能的路径（限制最大路径数量以避免指数爆炸）
     std::vector<std::vector<Point>> findAllPaths(Maze& maze, int maxPaths = 100);
     
@@ -77,23 +122,110 @@ public:
     static void printSearchResult(const SearchResult& result);
 
 private:
-    // DFS递归辅助函数
-    bool dfsHelper(Maze& maze, const Point& current, const Point& target,
-                   std::vector<Point>& path, std::vector<std::vector<bool>>& visited,
-                   int& visitedCount);
-    
-    // 计算曼哈顿距离（A*算法的启发式函数）
-    int manhattanDistance(const Point& a, const Point& b);
-    
-    // 重构路径（从A*算法的结果中提取路径）
-    std::vector<Point> reconstructPath(AStarNode* endNode);
-    
-    // 找到所有路径的DFS辅助函数
-    void findAllPathsDFS(Maze& maze, const Point& current, const Point& target,
-                        std::vector<Point>& currentPath, 
-                        std::vector<std::vector<Point>>& allPaths,
-                        std::vector<std::vector<bool>>& visited,
-                        int maxPaths);
+    // 显式栈DFS的栈帧：进入格子时取得的邻居列表和下一个要尝试的邻居下标
+    struct DfsFrame {
+        int cell;
+        int adjacent[NeighborList::CAPACITY];
+        unsigned char count = 0;
+        unsigned char next = 0;
+    };
+    
+    // 可复用的搜索缓冲区（按稠密格子编号平铺，重复求解时不再分配内存）
+    std::vector<int> parentIndex;      // 父格子编号
+    std::vector<unsigned> visitMark;   // 等于currentMark表示本次搜索中已访问
+    unsigned currentMark = 0;
+    RingQueue<int> frontier;           // BFS前沿队列
+    std::vector<DfsFrame> dfsStack;    // DFS显式栈（栈中格子即当前路径）
+    std::vector<int> gCost;            // A*、双向搜索：起点到格子的实际代价（仅对本次已访问的格子有效）
+    IndexedHeap openHeap;              // A*：开放列表，支持decrease-key
+    
+    // 双向搜索中反向（从出口出发）一侧的缓冲区，与上面的正向缓冲区一一对应
+    std::vector<unsigned> backwardMark;
+    std::vector<int> backwardCost;
+    std::vector<int> backwardParent;
+    RingQueue<int> backwardFrontier;
+    IndexedHeap backwardHeap;
+    
+    // 并行BFS使用的位图和线程私有缓冲区（按格子编号，每格1位）
+    std::vector<std::uint64_t> visitedBits;
+    std::vector<std::uint64_t> frontierBits;
+    std::vector<std::uint64_t> nextBits;
+    std::vector<int> frontierList;
+    std::vector<std::vector<int>> localFrontiers;
+    std::vector<int> localCounts;
+    std::shared_ptr<ThreadPool> threadPool;
+    int threadCount = 0;
+    
+    // 位并行BFS：每格一个64位字，第k位对应本组第k个起点
+    std::vector<std::uint64_t> laneVisited;
+    std::vector<std::uint64_t> laneFrontier;
+    std::vector<std::uint64_t> laneNext;
+    std::vector<int> laneCells;
+    std::vector<int> laneNextCells;
+    
+    ThreadPool& getThreadPool();
+    
+    // 开始一次新搜索：保证缓冲区足够大，并让上一次的访问标记全部失效
+    void beginSearch(int cellCount);
+    bool isVisited(int index) const { return visitMark[index] == currentMark; }
+    void markVisited(int index) { visitMark[index] = currentMark; }
+    void unmarkVisited(int index) { visitMark[index] = 0; }
+    // 在beginSearch之后调用，准备反向一侧的缓冲区
+    void beginBackwardSearch(int cellCount);
+    
+    // DFS主循环：找到终点时dfsStack中即为路径；返回访问的格子数
+    template <typename NeighborFn, typename Observer>
+    int dfsSearch(int source, int target, NeighborFn neighbors, Observer& observer, bool& found);
+    void pushDfsFrame(int cell);
+    
+    // BFS主循环：neighbors(index, out)返回邻居个数；返回访问的格子数
+    template <typename NeighborFn, typename Observer>
+    int bfsSearch(int source, int target, NeighborFn neighbors, Observer& observer, bool& found);
+    
+    // 批量求解的BFS：从source出发记录距离（gCost）和父格子，isGoal中的remaining个格子全部到达后停止；
+    // 返回访问的格子数
+    template <typename NeighborFn>
+    int batchBfsSearch(int source, const std::vector<char>& isGoal, int remaining, NeighborFn neighbors);
+    
+    // 位并行BFS：同时推进最多64个起点（origins），把距离写入对应的out数组；
+    // 返回平均每个前沿格子推进的搜索数（前沿重叠程度，1表示完全没有共享）
+    template <typename NeighborFn>
+    double bitParallelBfs(int cellCount, const int* origins, int laneCount,
+                        std::vector<int>* const* out, NeighborFn neighbors);
+    
+    // 并行BFS主循环，结果写入parentIndex；返回访问的格子数
+    template <typename NeighborFn>
+    int parallelBfsSearch(int cellCount, int source, int target, NeighborFn neighbors, bool& found);
+    
+    // A*主循环：heuristic(index)返回到终点的估计代价；返回出堆（扩展）的格子数
+    template <typename NeighborFn, typename HeuristicFn, typename Observer>
+    int astarSearch(int source, int target, NeighborFn neighbors, HeuristicFn heuristic, Observer& observer,
+                    bool& found);
+    
+    // 观察者在搜索开始前的准备：SearchTrace按格子数reset，其他观察者什么也不做；
+    // 在入口出口的有效性检查之前调用，提前返回时调用者也不会拿到上一次搜索的轨迹
+    static void prepareObserver(NullSearchObserver&, int) {}
+    static void prepareObserver(SearchTrace& trace, int cellCount) { trace.reset(cellCount); }
+    
+    // 双向搜索主循环：找到时meetFrom（正向一侧）与meetTo（反向一侧）相邻或相同，否则为-1；
+    // 返回访问（双向BFS）或扩展（双向A*）的格子数
+    template <typename NeighborFn>
+    int bidirectionalBfsSearch(int source, int target, NeighborFn neighbors, int& meetFrom, int& meetTo);
+    template <typename NeighborFn, typename ForwardHeuristicFn, typename BackwardHeuristicFn>
+    int bidirectionalAStarSearch(int source, int target, NeighborFn neighbors,
+                                 ForwardHeuristicFn forwardHeuristic, BackwardHeuristicFn backwardHeuristic,
+                                 int& meetFrom, int& meetTo);
+    // 拼接双向搜索的路径：source→meetFrom沿parentIndex，meetTo→target沿backwardParent
+    std::vector<Point> buildBidirectionalPath(const Maze& maze, int source, int target,
+                                              int meetFrom, int meetTo) const;
+    
+    // 沿parentIndex从goal回溯到start，返回从start到goal的路径
+    std::vector<Point> buildPathFromParents(const Maze& maze, int start, int goal) const;
+    
+    // 枚举所有路径的显式栈DFS，最多收集maxPaths条
+    template <typename NeighborFn>
+    void enumeratePaths(const Maze& maze, int source, int target, int maxPaths,
+                        std::vector<std::vector<Point>>& allPaths, NeighborFn neighbors);
 };
 
 #endif // PATHFINDER_H
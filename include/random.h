@@ -0,0 +1,118 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <utility>
+
+/**
+ * 随机数生成器 - xoshiro256++
+ * 功能：
+ * 1. 256位状态，由64位种子经splitmix64展开；同一个种子在任何平台上产生相同的序列
+ * 2. 满足UniformRandomBitGenerator，可以直接交给标准库的分布使用
+ * 3. below(n)用乘法取高位得到 [0, n) 内的整数，shuffle基于它实现，结果不依赖标准库的分布实现
+ * 4. jump()相当于调用2^128次，用来从同一个种子切分出互不重叠的子序列（每个线程或每个分块一个）
+ * 5. RandomBits把一次生成的64位拆开逐位使用，适合大量的硬币判定
+ */
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256(std::uint64_t seed = 0) { reseed(seed); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    // 用于没有指定种子的场合：从random_device取一个种子（调用者应记录下来以便复现）
+    static std::uint64_t randomSeed() {
+        std::random_device device;
+        return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+    }
+
+    void reseed(std::uint64_t seed) {
+        std::uint64_t x = seed;
+        for (int i = 0; i < 4; i++) {
+            // splitmix64
+            std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            s[i] = z ^ (z >> 31);
+        }
+    }
+
+    result_type operator()() {
+        std::uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // [0, bound) 内的整数（bound > 0）；乘法取高32位，偏差小于 bound / 2^32
+    std::uint32_t below(std::uint32_t bound) {
+        return static_cast<std::uint32_t>(((*this)() >> 32) * bound >> 32);
+    }
+
+    // [0, 1) 内的实数
+    double uniform() { return ((*this)() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Fisher-Yates洗牌
+    template <typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last) {
+        for (std::ptrdiff_t i = last - first - 1; i > 0; i--) {
+            std::swap(first[i], first[below(static_cast<std::uint32_t>(i + 1))]);
+        }
+    }
+
+    // 批量生成
+    void fill(std::uint64_t* out, std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) out[i] = (*this)();
+    }
+
+    // 前进2^128步
+    void jump() {
+        static const std::uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                             0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        std::uint64_t t[4] = {0, 0, 0, 0};
+        for (std::uint64_t mask : JUMP) {
+            for (int b = 0; b < 64; b++) {
+                if (mask & (std::uint64_t(1) << b)) {
+                    for (int i = 0; i < 4; i++) t[i] ^= s[i];
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; i++) s[i] = t[i];
+    }
+
+private:
+    std::uint64_t s[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+// 从生成器批量取64位，逐位作为硬币使用（不保存生成器，可以随所属对象一起复制）
+class RandomBits {
+public:
+    bool next(Xoshiro256& source) {
+        if (left == 0) {
+            bits = source();
+            left = 64;
+        }
+        left--;
+        bool heads = bits & 1;
+        bits >>= 1;
+        return heads;
+    }
+
+private:
+    std::uint64_t bits = 0;
+    int left = 0;
+};
+
+#endif // RANDOM_H
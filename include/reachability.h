@@ -0,0 +1,61 @@
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "maze.h"
+
+/**
+ * 可达性引擎 - 按位行扫描的泛洪填充
+ * 功能：
+ * 1. 可达格子用与MazeStorage相同布局的位行表示，每行wordsPerRow个64位字
+ * 2. 行内传播：由右墙位得到"与左/右邻格相连"的掩码，向右用加法进位一次填满整段走廊，
+ *    向左用移位倍增（1、2、4…32位）填充
+ * 3. 行间传播：上一行/下一行的可达位与下墙掩码按位与，作为本行新的种子
+ * 4. 以64位字为单位的工作栈：某个字新填充的位能通过打开的墙影响到的相邻字（上下两行、
+ *    左右两个字）才入栈重新处理，直到不动点；开阔区域一次处理64格，小的连通分量只处理用到的字
+ * 5. 非矩形迷宫（或构造时关闭位行模式）退化为逐格的显式栈泛洪
+ * 用途：出口是否可达、连通分量的数量和大小
+ */
+class ReachabilityEngine {
+public:
+    explicit ReachabilityEngine(const Maze& maze, bool useBitRows = true);
+
+    // 从start出发填充连通区域，返回其中的格子数；结果保留到下一次调用
+    std::size_t floodFill(const Point& start);
+    // 上一次floodFill之后p是否已被填充
+    bool isFilled(const Point& p) const;
+
+    // from和to是否连通
+    bool isReachable(const Point& from, const Point& to);
+
+    // 所有连通分量的大小（按行扫描首次遇到的顺序）
+    std::vector<std::size_t> componentSizes();
+
+    bool usesBitRows() const { return bitRows; }
+
+private:
+    const Maze& maze;
+    bool bitRows;
+    int rows, cols;
+    std::size_t words;                     // 每行的64位字数
+    std::uint64_t lastWordMask;            // 最后一个字中属于迷宫的位
+    std::vector<std::uint64_t> reach;      // 位行模式：rows × words
+    std::vector<char> queued;              // 位行模式：字是否已在工作栈中
+    std::vector<char> filled;              // 逐格模式：按稠密格子编号
+    std::vector<long long> stack;          // 工作栈：位行模式存字编号，逐格模式存格子编号
+
+    void clear();
+    // 在已有填充结果上继续从start填充，返回新增的格子数
+    std::size_t fillFrom(const Point& start);
+    std::size_t fillRows(int x, int y);
+    std::size_t fillCells(int start);
+    // 用相邻字的种子和行内传播更新第x行第w个字（extra为额外的种子），返回新增的格子数（不含extra）
+    std::size_t updateWord(int x, std::size_t w, std::uint64_t extra);
+    void enqueue(int x, std::size_t w);
+    // 第x行第w个字中"与右邻格相连"的掩码（不含右边界）
+    std::uint64_t linkRight(int x, std::size_t w) const;
+};
+
+#endif // REACHABILITY_H
@@ -0,0 +1,59 @@
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * 环形缓冲队列 - 用于搜索算法的前沿队列
+ * 功能：
+ * 1. 容量为2的幂，下标用位与取模
+ * 2. 满时容量翻倍，已分配的缓冲区在clear()后保留，重复搜索不再分配内存
+ * 3. 队列长度只取决于同时在前沿中的元素个数，而不是格子总数
+ */
+template <typename T>
+class RingQueue {
+public:
+    RingQueue() : buffer(16), head(0), tail(0) {}
+
+    void clear() { head = tail = 0; }
+    bool empty() const { return head == tail; }
+    std::size_t size() const { return tail - head; }
+    std::size_t capacity() const { return buffer.size(); }
+
+    void push(const T& value) {
+        if (size() == buffer.size()) grow();
+        buffer[tail & (buffer.size() - 1)] = value;
+        tail++;
+    }
+
+    T pop() {
+        T value = buffer[head & (buffer.size() - 1)];
+        head++;
+        return value;
+    }
+
+    const T& front() const { return buffer[head & (buffer.size() - 1)]; }
+
+    // 预留至少n个元素的容量
+    void reserve(std::size_t n) {
+        while (buffer.size() < n) grow();
+    }
+
+private:
+    std::vector<T> buffer;
+    std::size_t head, tail;  // 单调递增的读写计数
+
+    void grow() {
+        std::vector<T> larger(buffer.size() * 2);
+        std::size_t n = size();
+        for (std::size_t i = 0; i < n; i++) {
+            larger[i] = buffer[(head + i) & (buffer.size() - 1)];
+        }
+        buffer.swap(larger);
+        head = 0;
+        tail = n;
+    }
+};
+
+#endif // RING_QUEUE_H
@@ -0,0 +1,108 @@
+#ifndef ROUTING_INDEX_H
+#define ROUTING_INDEX_H
+
+#include "maze.h"
+#include "indexed_heap.h"
+#include <vector>
+#include <cstdint>
+
+/**
+ * 路由索引 - 针对同一个迷宫的大量起点/终点查询
+ * 功能：
+ * 1. 走廊收缩：度数不为2的格子（岔路口、死胡同）作为图节点，
+ *    节点之间由度数为2的格子组成的走廊收缩成一条带权边
+ * 2. 收缩层次（Contraction Hierarchies）：按重要性依次收缩节点并补充捷径边，
+ *    查询时只需沿"向上"的边做双向Dijkstra，搜索空间很小；
+ *    查询时使用按需停滞剪掉不可能在最短路径上的节点
+ * 3. 查询任意两个格子的最短距离或完整路径（捷径边和走廊边在返回前展开为格子序列）
+ * 注意：索引保存了迷宫的引用，迷宫的生命周期必须长于索引；修改迷宫后需要重新构建。
+ * 查询使用索引内部的缓冲区，同一个索引不能被多个线程同时查询。
+ */
+class RoutingIndex {
+public:
+    // 构建索引（预处理）
+    explicit RoutingIndex(const Maze& maze);
+
+    // 最短路径步数，不连通时返回-1
+    int distance(const Point& a, const Point& b);
+
+    // 最短路径（包含起点和终点），不连通时返回空
+    std::vector<Point> shortestPath(const Point& a, const Point& b);
+
+    // 统计信息
+    int getNodeCount() const { return static_cast<int>(nodeCell.size()); }
+    int getCorridorCount() const { return static_cast<int>(chains.size()); }
+    int getShortcutCount() const { return shortcutCount; }
+    double getBuildTime() const { return buildTime; }   // 毫秒
+    std::size_t memoryBytes() const;
+
+private:
+    // 走廊：from和to是两端的节点，内部格子按从from到to的顺序存放在chainCells中
+    struct Chain {
+        int from, to;
+        int length;      // 边数 = 内部格子数 + 1
+        int cellBegin;   // 内部格子在chainCells中的起始位置
+    };
+
+    // 向上的边：存放在层次较低的端点上；middle >= 0 表示捷径边（经过被收缩的middle），
+    // 否则chain是对应的走廊编号
+    struct UpEdge {
+        int to;
+        int weight;
+        int middle;
+        int chain;
+    };
+
+    // 单向搜索的缓冲区，访问标记与PathFinder一样按代际失效
+    struct SearchSpace {
+        std::vector<unsigned> mark;
+        std::vector<int> dist;
+        std::vector<int> parentEdge;   // 到达该节点所用的upEdges下标，-1表示是搜索起点
+        std::vector<int> parentNode;
+        IndexedHeap heap;
+    };
+
+    const Maze& maze;
+    int cellCount;
+
+    // 格子 -> 节点 / 走廊位置
+    std::vector<int> nodeOf;           // 节点编号，走廊格子为-1
+    std::vector<int> chainOf;          // 走廊格子所在的走廊编号
+    std::vector<int> chainPos;         // 走廊格子到from端的步数
+    std::vector<int> nodeCell;         // 节点 -> 格子编号
+    std::vector<Chain> chains;
+    std::vector<int> chainCells;
+
+    // 收缩层次：按CSR存放每个节点向上的边
+    std::vector<int> upFirst;
+    std::vector<UpEdge> upEdges;
+    int shortcutCount = 0;
+    double buildTime = 0.0;
+
+    // 查询缓冲区
+    SearchSpace forward, backward;
+    unsigned currentMark = 0;
+
+    void buildCorridors();
+    void buildHierarchy();
+
+    // 一个格子作为搜索端点时对应的(节点, 到该节点的步数)，走廊格子有两个
+    int entryNodes(int cell, int* nodes, int* offsets) const;
+
+    // 双向搜索，返回最短距离（不连通为-1）；meet为相遇节点，-1表示最短路径在同一条走廊内部
+    int query(int source, int target, int& meet);
+    void beginQuery();
+    void relax(SearchSpace& space, int node, int dist, int parentNode, int parentEdge);
+    bool stalled(const SearchSpace& space, int x) const;
+
+    // 在lower向上的边中查找通向higher的边
+    int findUpEdge(int lower, int higher) const;
+
+    // 将节点x到节点y的边（upEdges下标）展开为格子序列，追加到out（不含x，含y）
+    void appendEdgeCells(int x, int y, int edge, std::vector<int>& out) const;
+    // 追加走廊内从位置fromPos走到toPos经过的格子（不含起点，含终点；位置0和length为两端节点）
+    void appendChainCells(int chain, int fromPos, int toPos, std::vector<int>& out) const;
+    int chainCellAt(int chain, int pos) const;
+};
+
+#endif // ROUTING_INDEX_H
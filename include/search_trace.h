@@ -0,0 +1,72 @@
+#ifndef SEARCH_TRACE_H
+#define SEARCH_TRACE_H
+
+#include "maze.h"
+#include <vector>
+#include <cstddef>
+
+/**
+ * 搜索观察者 - PathFinder搜索主循环的编译期回调（模板参数，不是虚函数）
+ * 每个观察者提供：
+ *   onDiscover(cell)              格子第一次被发现（标记为已访问）
+ *   onExpand(cell, frontierSize)  格子被扩展；frontierSize为此时前沿中等待的格子数
+ * DFS没有单独的扩展步骤，格子入栈时同时调用两者，frontierSize为栈深度
+ */
+
+// 空观察者：回调都是空的内联函数，编译后与不带观察者的搜索完全相同
+struct NullSearchObserver {
+    void onDiscover(int) {}
+    void onExpand(int, int) {}
+};
+
+/**
+ * 搜索轨迹 - 记录一次搜索的扩展顺序、每步的前沿大小和每个格子的发现时刻
+ * 功能：
+ * 1. reset(cellCount)时按格子数预留缓冲区，记录过程中不再分配内存；多次搜索之间复用
+ * 2. 发现时刻用步数表示：发现该格子时已经扩展过的格子数，从未发现的格子为-1
+ * 3. 扩展顺序可以转换成坐标序列，交给Visualizer::animatePathFinding回放；
+ *    发现时刻交给Visualizer::exportHeatmapToHTML画成热力图
+ */
+class SearchTrace {
+public:
+    void reset(int cellCount) {
+        expansions.clear();
+        frontierSizes.clear();
+        expansions.reserve(cellCount);
+        frontierSizes.reserve(cellCount);
+        discoveryStep.assign(cellCount, -1);
+    }
+
+    void onDiscover(int cell) { discoveryStep[cell] = static_cast<int>(expansions.size()); }
+    void onExpand(int cell, int frontierSize) {
+        expansions.push_back(cell);
+        frontierSizes.push_back(frontierSize);
+    }
+
+    int getStepCount() const { return static_cast<int>(expansions.size()); }
+    int getCellCount() const { return static_cast<int>(discoveryStep.size()); }
+    const std::vector<int>& getExpansionOrder() const { return expansions; }
+    const std::vector<int>& getFrontierSizes() const { return frontierSizes; }
+    int getDiscoveryStep(int cell) const { return discoveryStep[cell]; }
+
+    int getMaxFrontier() const {
+        int maxSize = 0;
+        for (int size : frontierSizes) maxSize = size > maxSize ? size : maxSize;
+        return maxSize;
+    }
+
+    // 扩展顺序对应的坐标（格子编号由maze.fromIndex转换）
+    std::vector<Point> expansionPoints(const Maze& maze) const {
+        std::vector<Point> points;
+        points.reserve(expansions.size());
+        for (int cell : expansions) points.push_back(maze.fromIndex(cell));
+        return points;
+    }
+
+private:
+    std::vector<int> expansions;       // 第i步扩展的格子
+    std::vector<int> frontierSizes;    // 第i步扩展时前沿的大小
+    std::vector<int> discoveryStep;    // 按格子编号索引
+};
+
+#endif // SEARCH_TRACE_H
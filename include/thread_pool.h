@@ -0,0 +1,60 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/**
+ * 固定大小的线程池
+ * 功能：
+ * 1. 启动时创建固定数量的工作线程，之后反复复用
+ * 2. submit提交独立任务，wait等待所有已提交任务完成
+ * 3. parallelFor把区间切块分给所有线程执行，调用者线程也参与计算
+ * 4. currentWorker返回当前工作线程的编号，提交的任务可以据此使用线程私有的状态
+ */
+class ThreadPool {
+public:
+    // threadCount为0时使用硬件线程数
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 参与计算的线程总数（工作线程 + 调用者线程）
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    // 提交任务，由某个工作线程异步执行
+    void submit(std::function<void()> task);
+
+    // 阻塞直到所有已提交的任务执行完毕
+    void wait();
+
+    // 把[0, n)切成若干块并行执行 fn(begin, end, slot)，阻塞直到全部完成
+    // slot ∈ [0, size())，同一时刻不会有两个块使用相同的slot，可用于索引线程私有缓冲区
+    void parallelFor(int n, const std::function<void(int begin, int end, int slot)>& fn,
+                     int minChunk = 1024);
+
+    // 硬件线程数（至少为1）
+    static int hardwareThreads();
+
+    // 当前线程在所属线程池中的编号：工作线程为 [1, size())，其他线程为0
+    static int currentWorker();
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskReady;
+    std::condition_variable allDone;
+    int pending;     // 已提交但尚未完成的任务数
+    bool stopping;
+
+    void workerLoop(int index);
+};
+
+#endif // THREAD_POOL_H
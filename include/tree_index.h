@@ -0,0 +1,60 @@
+#ifndef TREE_INDEX_H
+#define TREE_INDEX_H
+
+#include <vector>
+#include <cstdint>
+
+class Maze;
+
+/**
+ * 树索引 - 完美迷宫（生成树）上的O(1)距离查询
+ * 功能：
+ * 1. 完美迷宫任意两个格子之间恰好有一条路径，以格子0为根把迷宫看成一棵树，
+ *    用平铺数组保存每个格子的父格子、深度和先序编号
+ * 2. 最近公共祖先（LCA）：对先序编号为tin[u]<tin[v]的两个格子，
+ *    区间(tin[u], tin[v]]内父格子先序编号的最小值就是LCA的先序编号；
+ *    区间最小值用"块间稀疏表 + 块内单调栈位掩码"在O(1)内得到
+ * 3. 距离 = depth[a] + depth[b] - 2 × depth[lca]，路径沿父指针输出，O(路径长度)
+ * 4. 迷宫不是树（有环或不连通，例如随机墙壁生成、手动拆墙之后）时拒绝构建，isTree()返回false
+ */
+class TreeIndex {
+public:
+    explicit TreeIndex(const Maze& maze);
+
+    // 迷宫是否是一棵生成树；为false时索引为空，不能查询
+    bool isTree() const { return tree; }
+
+    // 按稠密格子编号查询
+    int lca(int a, int b) const;
+    int distance(int a, int b) const { return depth[a] + depth[b] - 2 * depth[lca(a, b)]; }
+    // 从a到b的格子编号序列（包含两端）
+    std::vector<int> path(int a, int b) const;
+
+    int getDepth(int cell) const { return depth[cell]; }
+    int getParent(int cell) const { return parent[cell]; }   // 根的父格子为-1
+
+    // 占用的字节数
+    std::size_t memoryBytes() const;
+
+private:
+    // 块内位掩码的宽度
+    static const int BLOCK = 64;
+
+    bool tree = false;
+    std::vector<int> parent;            // 格子 -> 父格子
+    std::vector<int> depth;             // 格子 -> 深度（根为0）
+    std::vector<int> tin;               // 格子 -> 先序编号
+    std::vector<int> order;             // 先序编号 -> 格子
+
+    // 区间最小值结构，数组为 key[i] = tin[parent[order[i]]]（i >= 1）
+    std::vector<int> key;
+    std::vector<std::uint64_t> stackMask;  // 块内：以i结尾时单调栈中元素的位置
+    std::vector<int> blockMin;             // blockMin[k][b]：从块b开始2^k个块的最小值，按层拼接
+    int blockCount = 0;
+
+    void buildRangeMin();
+    int rangeMin(int l, int r) const;    // key在[l, r]上的最小值
+    int blockRangeMin(int b1, int b2) const;
+};
+
+#endif // TREE_INDEX_H
@@ -8,6 +8,7 @@
 #include <chrono>
 #include <thread>
 #include "mondrian_maze.h"
+#include "maze_renderer.h"
 
 class CircularMaze; // 前向声明
 
@@ -17,7 +18,7 @@ class CircularMaze; // 前向声明
  * 1. ASCII字符界面显示迷宫（使用线段表示墙壁）
  * 2. 动画显示路径寻找过程
  * 3. 彩色终端输出（如果支持）
- * 4. 导出HTML和文本文件
+ * 4. 导出HTML和文本文件，以及搜索过程的热力图
  * 5. 统计信息显示
  */
 class Visualizer {
@@ -54,6 +55,8 @@ private:
     DisplayMode mode;
     bool useColors;
     int animationDelay;  // 动画延迟（毫秒）
+    mutable MazeRenderer renderer;  // 矩形迷宫的帧缓冲区，多次显示之间复用
+    bool quiet = false;             // 导出时不输出提示
 
 public:
     // 构造函数
@@ -63,6 +66,9 @@ public:
     void setMode(DisplayMode newMode);
     void setUseColors(bool useColorOutput);
     void setAnimationDelay(int delay);
+    // 静默模式：导出函数不向std::cout和std::cerr输出提示，只通过返回值报告结果；
+    // 批处理和服务器模式的工作线程使用，各线程可以同时导出而不共享任何输出流
+    void setQuiet(bool quietMode) { quiet = quietMode; }
     
     // 显示迷宫
     void displayMaze(const Maze& maze) const;
@@ -72,15 +78,25 @@ public:
     void animatePathFinding(Maze& maze, const std::vector<Point>& searchOrder, 
                            const std::vector<Point>& finalPath) const;
     
-    // 导出功能
-    void exportToHTML(const Maze& maze, const std::vector<Point>& path, 
-                     const std::string& filename) const;
-    void exportCircularToHTML(const CircularMaze& maze, const std::vector<Point>& path,
+    // HTML导出的布局
+    enum HtmlLayout {
+        HTML_AUTO,   // 格子数不超过2500时用GRID，否则用SVG
+        HTML_GRID,   // 每格一个div，路径格子带方向箭头
+        HTML_SVG     // 墙壁合并成连续线段放进一条SVG路径，文件大小与墙段数成正比（只支持矩形迷宫）
+    };
+    
+    // 导出功能：返回是否成功写出文件
+    bool exportToHTML(const Maze& maze, const std::vector<Point>& path, 
+                     const std::string& filename, HtmlLayout layout = HTML_AUTO) const;
+    bool exportCircularToHTML(const CircularMaze& maze, const std::vector<Point>& path,
                               const std::string& filename) const; // 新增函数
-    void exportToText(const Maze& maze, const std::vector<Point>& path, 
+    bool exportToText(const Maze& maze, const std::vector<Point>& path, 
                      const std::string& filename) const;
-    void exportMondrianToHTML(const MondrianMaze& maze, const std::vector<int>& path, const std::string& filename) const;
-    void exportMondrianMultiPathsToHTML(const MondrianMaze& maze, const std::vector<std::vector<int>>& paths, int shortestIdx, const std::string& filename) const;
+    bool exportMondrianToHTML(const MondrianMaze& maze, const std::vector<int>& path, const std::string& filename) const;
+    bool exportMondrianMultiPathsToHTML(const MondrianMaze& maze, const std::vector<std::vector<int>>& paths, int shortestIdx, const std::string& filename) const;
+    // 搜索热力图（矩形迷宫）：按SearchTrace记录的发现时刻给格子着色，叠加墙壁和路径
+    bool exportHeatmapToHTML(const Maze& maze, const SearchTrace& trace, const std::vector<Point>& path,
+                             const std::string& filename) const;
     
     // 统计信息显示
     void printStatistics(const Maze& maze) const;
@@ -96,12 +112,20 @@ public:
 private:
     // 迷宫显示相关
     void displayMazeWithLineWalls(const Maze& maze) const;
+    // 终端上的矩形迷宫：整帧只画一次，之后按显示周期批量重画新访问的格子
+    void animateIncrementally(Maze& maze, const std::vector<Point>& searchOrder) const;
     std::string getCellSymbol(const MazeCell& cell) const;
     std::string getConnector(bool hasLeft, bool hasRight, bool hasTop, bool hasBottom) const; // Changed return type to std::string
     
-    // HTML生成
+    // 逐格打印线段墙壁（非矩形迷宫和导出使用）；path中除入口和出口以外的格子画成已访问
+    void writeLineWalls(const Maze& maze, const std::vector<Point>& path, std::ostream& out) const;
+    void writePathInfo(const std::vector<Point>& path, std::ostream& out) const;
+    
+    // HTML生成：迷宫部分边生成边写入out，不在内存中拼出整个文档
     std::string generateHTMLHeader() const;
-    std::string generateMazeHTML(const Maze& maze, const std::vector<Point>& path) const;
+    void writeMazeHTML(const Maze& maze, const std::vector<Point>& path, std::ostream& html) const;
+    void writeMazeSVG(const Maze& maze, const std::vector<Point>& path, std::ostream& out) const;
+    void writeInfoPanel(const Maze& maze, const std::vector<Point>& path, std::ostream& html) const;
     std::string generateHTMLFooter() const;
     
     // 颜色和样式
@@ -11,6 +11,10 @@ CircularMaze::CircularMaze(int rings) : Maze(std::max(3, rings), 0), rings(std::
         int n = std::max(6, 6 * (1 << i)); // 每一环至少6个格子
         cells_in_ring.push_back(n);
     }
+    ring_offsets.assign(this->rings + 1, 0);
+    for (int i = 0; i < this->rings; ++i) {
+        ring_offsets[i + 1] = ring_offsets[i] + cells_in_ring[i];
+    }
     horizontal_walls.resize(this->rings);
     vertical_walls.resize(this->rings);
     for (int i = 0; i < this->rings; ++i) {
@@ -27,14 +31,14 @@ void CircularMaze::generate() {
     for(int i = 0; i < rings; ++i) {
         visited[i].assign(cells_in_ring[i], false);
     }
-    std::mt19937 rng(std::random_device{}());
+    Xoshiro256& rng = getRng();
     Point start = {0, 0};
     s.push(start);
     visited[start.x][start.y] = true;
     while(!s.empty()){
         Point current = s.top();
         std::vector<Point> neighbors = getAllNeighbors(current);
-        std::shuffle(neighbors.begin(), neighbors.end(), rng);
+        rng.shuffle(neighbors.begin(), neighbors.end());
         Point next = {-1, -1};
         for(const auto& n : neighbors) {
             if(isValidPosition(n) && !visited[n.x][n.y]) {
@@ -52,28 +56,28 @@ void CircularMaze::generate() {
     }
 }
 
-std::vector<Point> CircularMaze::getAccessibleNeighbors(const Point& p) const {
-    std::vector<Point> neighbors;
+void CircularMaze::getAccessibleNeighbors(const Point& p, NeighborList& neighbors) const {
+    neighbors.clear();
     int r = p.x;
-    if (r < 0 || r >= rings) return neighbors;
+    if (r < 0 || r >= rings) return;
     int i = p.y;
     int num_cells = cells_in_ring[r];
-    if (i < 0 || i >= num_cells) return neighbors;
+    if (i < 0 || i >= num_cells) return;
     // Clockwise
     if (num_cells > 0 && !vertical_walls[r][i]) {
-        neighbors.push_back({r, (i + 1) % num_cells});
+        neighbors.push({r, (i + 1) % num_cells});
     }
     // Counter-clockwise
     if (num_cells > 0 && !vertical_walls[r][(i - 1 + num_cells) % num_cells]) {
-        neighbors.push_back({r, (i - 1 + num_cells) % num_cells});
+        neighbors.push({r, (i - 1 + num_cells) % num_cells});
     }
     // Outward
     if (r + 1 < rings && num_cells > 0 && !horizontal_walls[r][i]) {
         int outer_cells = cells_in_ring[r+1];
         float ratio = (float)outer_cells / num_cells;
-        neighbors.push_back({r + 1, (int)(i * ratio) % outer_cells});
+        neighbors.push({r + 1, (int)(i * ratio) % outer_cells});
         if (ratio > 1.5) {
-             neighbors.push_back({r + 1, ((int)(i * ratio) + 1) % outer_cells});
+             neighbors.push({r + 1, ((int)(i * ratio) + 1) % outer_cells});
         }
     }
     // Inward
@@ -82,10 +86,9 @@ std::vector<Point> CircularMaze::getAccessibleNeighbors(const Point& p) const {
         float ratio = (float)num_cells / inner_cells;
         int inner_idx = (int)(i / ratio);
         if (inner_idx >= 0 && inner_idx < inner_cells && !horizontal_walls[r-1][inner_idx]) {
-            neighbors.push_back({r - 1, inner_idx});
+            neighbors.push({r - 1, inner_idx});
         }
     }
-    return neighbors;
 }
 
 bool CircularMaze::isValidPosition(const Point& p) const {
@@ -94,6 +97,34 @@ bool CircularMaze::isValidPosition(const Point& p) const {
     return true;
 }
 
+int CircularMaze::getCellCount() const {
+    return ring_offsets[rings];
+}
+
+int CircularMaze::toIndex(const Point& p) const {
+    return ring_offsets[p.x] + p.y;
+}
+
+Point CircularMaze::fromIndex(int index) const {
+    // 环数很少，二分查找所在的环
+    int r = int(std::upper_bound(ring_offsets.begin(), ring_offsets.end(), index) - ring_offsets.begin()) - 1;
+    return {r, index - ring_offsets[r]};
+}
+
+int CircularMaze::getNeighborIndices(int index, int* out) const {
+    NeighborList neighbors;
+    getAccessibleNeighbors(fromIndex(index), neighbors);
+    for (int k = 0; k < neighbors.size(); ++k) {
+        out[k] = toIndex(neighbors[k]);
+    }
+    return neighbors.size();
+}
+
+int CircularMaze::getDistanceLowerBound(int from, int to) const {
+    // 每一步最多跨越一环，环号之差是一致的下界
+    return std::abs(fromIndex(from).x - fromIndex(to).x);
+}
+
 int CircularMaze::getCellsInRing(int ring) const {
     if (ring >= 0 && ring < rings) {
         return cells_in_ring[ring];
@@ -135,7 +166,9 @@ std::vector<Point> CircularMaze::getAllNeighbors(const Point& p) const {
 
 void CircularMaze::removeWallBetween(const Point& a, const Point& b) {
     if (a.x == b.x) { // Same ring, must be a vertical (radial) wall
-        int i = std::min(a.y, b.y);
+        // vertical_walls[r][i] 位于格子i和(i+1)%n之间，首尾相接时不能简单取较小的下标
+        int n = cells_in_ring[a.x];
+        int i = ((a.y + 1) % n == b.y) ? a.y : b.y;
         if (a.x >= 0 && a.x < rings && i >= 0 && i < (int)vertical_walls[a.x].size())
             this->vertical_walls[a.x][i] = false;
     } else { // Different rings, must be a horizontal (concentric) wall
@@ -143,4 +176,5 @@ void CircularMaze::removeWallBetween(const Point& a, const Point& b) {
         if (inner.x >= 0 && inner.x < rings && inner.y >= 0 && inner.y < (int)horizontal_walls[inner.x].size())
             this->horizontal_walls[inner.x][inner.y] = false;
     }
+    wallsChanged();
 } 
\ No newline at end of file
@@ -0,0 +1,406 @@
+#include "batch_runner.h"
+#include "CircularMaze.h"
+#include "mondrian_maze.h"
+#include "maze_file.h"
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+/**
+ * 批处理模式的实现
+ * 结果行只写到调用者给定的流；导出使用静默的visualizer和MazeFile::save，出错只记录在作业结果中，
+ * 作业执行过程不写std::cout和std::cerr，多个执行器可以在不同线程上同时运行（见JobServer）
+ */
+
+namespace {
+
+const char* const ALL_SOLVERS[] = {"bfs", "dfs", "astar", "bibfs", "biastar", "jps", "tree", "pbfs"};
+
+bool parseInt(const std::string& value, long long minValue, long long maxValue, long long& result) {
+    if (value.empty()) return false;
+    char* end = nullptr;
+    long long parsed = std::strtoll(value.c_str(), &end, 10);
+    if (*end != '\0' || parsed < minValue || parsed > maxValue) return false;
+    result = parsed;
+    return true;
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+bool JobSpec::set(const std::string& key, const std::string& value, std::string& error) {
+    long long number = 0;
+    if (key == "type") {
+        if (value != "rect" && value != "circular" && value != "mondrian") {
+            error = "未知的迷宫类型: " + value;
+            return false;
+        }
+        type = value;
+    } else if (key == "rows" || key == "cols" || key == "rings" || key == "repeat") {
+        long long maxValue = (key == "rings") ? 24 : 1000000000;
+        if (!parseInt(value, 1, maxValue, number)) {
+            error = key + " 必须是1到" + std::to_string(maxValue) + "之间的整数";
+            return false;
+        }
+        if (key == "rows") rows = static_cast<int>(number);
+        else if (key == "cols") cols = static_cast<int>(number);
+        else if (key == "rings") rings = static_cast<int>(number);
+        else repeat = static_cast<int>(number);
+    } else if (key == "size") {
+        // size=RxC 同时设置行列数
+        std::size_t x = value.find('x');
+        std::string error2;
+        if (x == std::string::npos || !set("rows", value.substr(0, x), error2) || !set("cols", value.substr(x + 1), error2)) {
+            error = "size 的格式为 行x列，例如 100x200";
+            return false;
+        }
+    } else if (key == "generator") {
+        if (value != "dfs" && value != "kruskal" && value != "eller" && value != "parallel" && value != "random") {
+            error = "未知的生成算法: " + value;
+            return false;
+        }
+        generator = value;
+    } else if (key == "wall_removal") {
+        char* end = nullptr;
+        wallRemoval = std::strtod(value.c_str(), &end);
+        if (value.empty() || *end != '\0' || wallRemoval < 0.0 || wallRemoval > 1.0) {
+            error = "wall_removal 必须在0到1之间";
+            return false;
+        }
+    } else if (key == "seed") {
+        char* end = nullptr;
+        seed = std::strtoull(value.c_str(), &end, 10);
+        if (value.empty() || *end != '\0') {
+            error = "seed 必须是非负整数";
+            return false;
+        }
+    } else if (key == "solvers" || key == "solver") {
+        solvers.clear();
+        std::stringstream list(value);
+        std::string name;
+        while (std::getline(list, name, ',')) {
+            if (name.empty()) continue;
+            if (name == "all") {
+                solvers.assign(std::begin(ALL_SOLVERS), std::end(ALL_SOLVERS));
+                continue;
+            }
+            bool known = false;
+            for (const char* solver : ALL_SOLVERS) known = known || name == solver;
+            if (!known) {
+                error = "未知的求解算法: " + name;
+                return false;
+            }
+            solvers.push_back(name);
+        }
+    } else if (key == "export") {
+        if (value != "text" && value != "html" && value != "maze" && value != "none") {
+            error = "未知的导出格式: " + value;
+            return false;
+        }
+        exportFormat = (value == "none") ? "" : value;
+    } else if (key == "output") {
+        output = value;
+    } else {
+        error = "未知的参数: " + key;
+        return false;
+    }
+    return true;
+}
+
+bool JobSpec::parseLine(const std::string& line, bool& empty, std::string& error) {
+    std::string content = line.substr(0, line.find('#'));
+    std::stringstream tokens(content);
+    std::string token;
+    empty = true;
+    while (tokens >> token) {
+        empty = false;
+        std::size_t eq = token.find('=');
+        if (eq == std::string::npos) {
+            error = "参数应写成 key=value: " + token;
+            return false;
+        }
+        if (!set(token.substr(0, eq), token.substr(eq + 1), error)) return false;
+    }
+    return empty || validate(error);
+}
+
+bool JobSpec::parseArguments(const std::vector<std::string>& args, std::string& error) {
+    for (std::size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
+        std::size_t eq = arg.find('=');
+        std::size_t start = (arg.compare(0, 2, "--") == 0) ? 2 : 0;
+        if (eq != std::string::npos) {
+            if (!set(arg.substr(start, eq - start), arg.substr(eq + 1), error)) return false;
+        } else if (start == 2 && i + 1 < args.size()) {
+            if (!set(arg.substr(2), args[++i], error)) return false;
+        } else {
+            error = "无法解析的参数: " + arg;
+            return false;
+        }
+    }
+    return validate(error);
+}
+
+bool JobSpec::validate(std::string& error) const {
+    // rows和cols分别设置，只有在这里才能检查乘积；格子编号是int，超出时生成和搜索都会溢出
+    if (type == "rect" && !Maze::isSupportedSize(rows, cols)) {
+        error = "rows*cols 不能超过" + std::to_string(INT_MAX) + "个格子";
+        return false;
+    }
+    return true;
+}
+
+BatchRunner::BatchRunner() : visualizer(Visualizer::SIMPLE, false, 0) {
+    visualizer.setQuiet(true);
+}
+
+bool BatchRunner::run(const JobSpec& spec, std::ostream& out) {
+    // 没有指定种子时随机选一个，重复的作业依次加1，结果行中记录实际种子以便复现
+    std::uint64_t seed = spec.seed != 0 ? spec.seed : Xoshiro256::randomSeed();
+    bool ok = true;
+    for (int i = 0; i < spec.repeat; i++) {
+        JobResult result;
+        ok = execute(spec, seed + static_cast<std::uint64_t>(i), result) && ok;
+        writeLine(spec, jobCount, result, out);
+    }
+    return ok;
+}
+
+int BatchRunner::runJobFile(std::istream& in, std::ostream& out) {
+    std::string line;
+    int failed = 0;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        JobSpec spec;
+        bool empty = false;
+        std::string error;
+        if (!spec.parseLine(line, empty, error)) {
+            out << "line=" << lineNumber << " error=\"" << error << "\"\n";
+            failed++;
+            continue;
+        }
+        if (!empty && !run(spec, out)) failed++;
+    }
+    out.flush();
+    return failed;
+}
+
+void BatchRunner::writeLine(const JobSpec& spec, int job, const JobResult& result, std::ostream& out) {
+    out << "job=" << job << " type=" << spec.type;
+    if (spec.type == "circular") {
+        out << " rings=" << spec.rings;
+    } else if (spec.type == "rect") {
+        out << " rows=" << spec.rows << " cols=" << spec.cols;
+    }
+    if (spec.type != "mondrian") out << " generator=" << spec.generator;
+    out << " seed=" << result.seed;
+    if (spec.type == "mondrian") out << " rooms=" << result.rooms;
+    out << " generate_ms=" << result.generateTime;
+    if (result.cached) out << " cached=1";
+    for (const SolverStats& solver : result.solvers) {
+        const std::string& name = solver.name;
+        out << " " << name << ".found=" << solver.found << " " << name << ".steps=" << solver.steps;
+        if (spec.type != "mondrian") out << " " << name << ".visited=" << solver.visitedNodes;
+        out << " " << name << ".ms=" << solver.searchTime;
+    }
+    if (!result.exportPath.empty()) out << " export=" << result.exportPath;
+    if (!result.error.empty()) out << " error=\"" << result.error << "\"";
+    out << "\n";
+}
+
+std::string BatchRunner::expandOutput(const std::string& pattern, int jobNumber, std::uint64_t seed) {
+    std::string result;
+    for (std::size_t i = 0; i < pattern.size(); i++) {
+        if (pattern.compare(i, 3, "{n}") == 0) {
+            result += std::to_string(jobNumber);
+            i += 2;
+        } else if (pattern.compare(i, 6, "{seed}") == 0) {
+            result += std::to_string(seed);
+            i += 5;
+        } else {
+            result += pattern[i];
+        }
+    }
+    return result;
+}
+
+std::string BatchRunner::makeKey(const JobSpec& spec, std::uint64_t seed) {
+    std::string key = spec.type + "/" + spec.generator + "/" + std::to_string(seed);
+    if (spec.type == "circular") {
+        key += "/" + std::to_string(spec.rings);
+    } else if (spec.type == "rect") {
+        key += "/" + std::to_string(spec.rows) + "x" + std::to_string(spec.cols);
+        if (spec.generator == "random") key += "/" + std::to_string(spec.wallRemoval);
+    }
+    return key;
+}
+
+Maze& BatchRunner::prepareMaze(const JobSpec& spec) {
+    if (spec.type == "circular") {
+        maze.reset(new CircularMaze(spec.rings));
+    } else if (!maze || dynamic_cast<CircularMaze*>(maze.get()) ||
+               maze->getRows() != spec.rows || maze->getCols() != spec.cols || maze->getStorage().isExternal()) {
+        maze.reset(new Maze(spec.rows, spec.cols));
+    }
+    // 规模相同时直接复用：生成算法会重置全部墙壁，入口出口在批处理中不会改变
+    return *maze;
+}
+
+bool BatchRunner::generate(Maze& target, const JobSpec& spec, std::uint64_t seed, std::string& error) {
+    if (spec.type == "circular") {
+        if (spec.generator != "dfs") {
+            error = "圆形迷宫只支持dfs生成";
+            return false;
+        }
+        target.setSeed(seed);
+        target.generate();
+        return true;
+    }
+
+    target.setSeed(seed);
+    if (spec.generator == "parallel") {
+        target.generateParallel(seed);
+    } else if (spec.generator == "random") {
+        target.generateRandomMaze(spec.wallRemoval);
+    } else {
+        target.setGenerationAlgorithm(spec.generator == "kruskal" ? GenerationAlgorithm::KRUSKAL
+                                      : spec.generator == "eller" ? GenerationAlgorithm::ELLER
+                                                                  : GenerationAlgorithm::DFS);
+        target.generate();
+    }
+    return true;
+}
+
+bool BatchRunner::solve(Maze& target, const std::string& solver, PathFinder::SearchResult& result) {
+    if (solver == "bfs") result = pathFinder.findPathBFS(target);
+    else if (solver == "dfs") result = pathFinder.findPathDFS(target);
+    else if (solver == "astar") result = pathFinder.findPathAStar(target);
+    else if (solver == "bibfs") result = pathFinder.findPathBidirectionalBFS(target);
+    else if (solver == "biastar") result = pathFinder.findPathBidirectionalAStar(target);
+    else if (solver == "jps") result = pathFinder.findPathJPS(target);
+    else if (solver == "tree") result = pathFinder.findPathTree(target);
+    else if (solver == "pbfs") result = pathFinder.findPathParallelBFS(target);
+    else return false;
+    return true;
+}
+
+bool BatchRunner::exportMaze(const Maze& target, const JobSpec& spec, const std::vector<Point>& path,
+                             const std::string& output, std::string& error) {
+    if (output.empty()) {
+        error = "导出需要指定output";
+        return false;
+    }
+    // visualizer和MazeFile::save都以静默方式调用：导出只写自己的文件，不碰std::cout和std::cerr，
+    // 多个执行器可以在不同线程上同时导出；失败通过返回值变成这个作业的错误
+    bool written = true;
+    if (spec.exportFormat == "text") {
+        written = visualizer.exportToText(target, path, output);
+    } else if (spec.exportFormat == "html") {
+        if (const CircularMaze* circular = dynamic_cast<const CircularMaze*>(&target)) {
+            written = visualizer.exportCircularToHTML(*circular, path, output);
+        } else {
+            written = visualizer.exportToHTML(target, path, output);
+        }
+    } else if (spec.exportFormat == "maze") {
+        if (!target.isRectangularGrid()) {
+            error = "二进制迷宫文件只支持矩形迷宫";
+            return false;
+        }
+        if (!MazeFile::save(target, output, true)) {
+            error = "无法写入 " + output;
+            return false;
+        }
+    }
+    if (!written) {
+        error = "无法写入 " + output;
+        return false;
+    }
+    return true;
+}
+
+bool BatchRunner::executeMondrian(const JobSpec& spec, std::uint64_t seed, const std::string& output, JobResult& result) {
+    std::string key = makeKey(spec, seed);
+    if (mondrian && key == mazeKey) {
+        result.cached = true;
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        mondrian.reset(new MondrianMaze(seed));
+        mazeKey = key;
+        result.generateTime = elapsedMs(start);
+    }
+    result.rooms = mondrian->getRoomCount();
+
+    // 蒙德里安迷宫只有一种房间图上的最短路径搜索，solvers中的每一项都用它
+    std::vector<int> path;
+    for (const std::string& solver : spec.solvers) {
+        auto start = std::chrono::steady_clock::now();
+        path = mondrian->findPath(mondrian->getEntranceId(), mondrian->getExitId(), 1);
+        SolverStats stats;
+        stats.name = solver;
+        stats.found = !path.empty();
+        stats.steps = path.empty() ? 0 : static_cast<int>(path.size()) - 1;
+        stats.searchTime = elapsedMs(start);
+        result.solvers.push_back(stats);
+    }
+    if (!spec.exportFormat.empty()) {
+        if (spec.exportFormat != "html" || output.empty()) {
+            result.error = "蒙德里安迷宫只能导出html，且需要指定output";
+            return false;
+        }
+        if (!visualizer.exportMondrianToHTML(*mondrian, path, output)) {
+            result.error = "无法写入 " + output;
+            return false;
+        }
+        result.exportPath = output;
+    }
+    return true;
+}
+
+bool BatchRunner::execute(const JobSpec& spec, std::uint64_t seed, JobResult& result, int jobNumber) {
+    jobCount++;
+    result.seed = seed;
+    if (!spec.validate(result.error)) return false;
+    std::string output = expandOutput(spec.output, jobNumber > 0 ? jobNumber : jobCount, seed);
+    if (spec.type == "mondrian") {
+        return executeMondrian(spec, seed, output, result);
+    }
+
+    std::string key = makeKey(spec, seed);
+    if (maze && key == mazeKey) {
+        result.cached = true;
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        mazeKey.clear();
+        Maze& target = prepareMaze(spec);
+        if (!generate(target, spec, seed, result.error)) return false;
+        mazeKey = key;
+        result.generateTime = elapsedMs(start);
+    }
+
+    // 导出时使用第一个找到路径的算法的结果
+    std::vector<Point> exportPath;
+    PathFinder::SearchResult searchResult;
+    for (const std::string& solver : spec.solvers) {
+        solve(*maze, solver, searchResult);
+        SolverStats stats;
+        stats.name = solver;
+        stats.found = searchResult.found;
+        stats.steps = searchResult.steps;
+        stats.visitedNodes = searchResult.visitedNodes;
+        stats.searchTime = searchResult.searchTime;
+        result.solvers.push_back(stats);
+        if (searchResult.found && exportPath.empty()) exportPath = std::move(searchResult.path);
+    }
+
+    if (!spec.exportFormat.empty()) {
+        if (!exportMaze(*maze, spec, exportPath, output, result.error)) return false;
+        result.exportPath = output;
+    }
+    return true;
+}
@@ -0,0 +1,280 @@
+#include "pathfinder.h"
+#include <chrono>
+#include <climits>
+
+/**
+ * 批量求解的实现
+ * 1. 迷宫的通行关系是对称的：起点多于目标时改为从每个目标出发，结果按转置写回
+ * 2. 每次BFS只需要到达全部目标（或另一侧的全部格子），到达后立即停止，不必遍历整个迷宫
+ * 3. 所有BFS共用PathFinder的平铺缓冲区，访问标记按代际失效，不会为每次搜索重新分配内存
+ * 4. 位并行BFS：每格一个64位字，第k位表示第k个搜索的状态。一层扩展对每个前沿格子做
+ *    next[邻居] |= frontier[格子] & ~visited[邻居]，64个搜索共享同一次邻居读取和墙壁判断；
+ *    多个起点距离相近时（前沿重叠）收益最大
+ */
+
+namespace {
+
+// 一组起点少于这个数时位并行没有收益，逐个做普通BFS
+const int BIT_PARALLEL_MIN_SOURCES = 4;
+const int LANES = 64;
+
+// 位并行BFS每处理一个前沿格子平均推进的搜索数低于这个值时，不如逐个BFS
+const double MIN_LANE_SHARING = 2.0;
+
+// Z序（Morton码）：交错x、y的二进制位，相近的格子得到相近的值
+std::uint64_t interleaveBits(unsigned x, unsigned y) {
+    std::uint64_t code = 0;
+    for (int b = 0; b < 32; b++) {
+        code |= static_cast<std::uint64_t>((x >> b) & 1u) << (2 * b + 1);
+        code |= static_cast<std::uint64_t>((y >> b) & 1u) << (2 * b);
+    }
+    return code;
+}
+
+} // namespace
+
+int PathFinder::BatchResult::nearestTarget(int source) const {
+    int best = -1;
+    for (int j = 0; j < targetCount; j++) {
+        int d = distance(source, j);
+        if (d >= 0 && (best < 0 || d < distance(source, best))) {
+            best = j;
+        }
+    }
+    return best;
+}
+
+template <typename NeighborFn>
+int PathFinder::batchBfsSearch(int source, const std::vector<char>& isGoal, int remaining, NeighborFn neighbors) {
+    frontier.push(source);
+    markVisited(source);
+    parentIndex[source] = source;
+    gCost[source] = 0;
+    int visitedCount = 1;
+    if (isGoal[source]) remaining--;
+
+    int adjacent[NeighborList::CAPACITY];
+    while (remaining > 0 && !frontier.empty()) {
+        int current = frontier.pop();
+        int count = neighbors(current, adjacent);
+        for (int k = 0; k < count; k++) {
+            int next = adjacent[k];
+            if (!isVisited(next)) {
+                markVisited(next);
+                visitedCount++;
+                parentIndex[next] = current;
+                gCost[next] = gCost[current] + 1;
+                frontier.push(next);
+                if (isGoal[next]) remaining--;
+            }
+        }
+    }
+    frontier.clear();
+    return visitedCount;
+}
+
+PathFinder::BatchResult PathFinder::findDistances(const Maze& maze, const std::vector<Point>& sources,
+                                                  const std::vector<Point>& targets, bool withPaths) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    BatchResult result;
+    result.sourceCount = static_cast<int>(sources.size());
+    result.targetCount = static_cast<int>(targets.size());
+    result.distances.assign(sources.size() * targets.size(), -1);
+    if (withPaths) {
+        result.paths.resize(result.distances.size());
+    }
+
+    // 从较少的一侧出发；swapped为true时"出发点"是目标，"终点"是起点
+    bool swapped = targets.size() < sources.size();
+    const std::vector<Point>& origins = swapped ? targets : sources;
+    const std::vector<Point>& goals = swapped ? sources : targets;
+
+    int cellCount = maze.getCellCount();
+    std::vector<int> goalCells(goals.size(), -1);
+    std::vector<char> isGoal(cellCount, 0);
+    int distinctGoals = 0;
+    for (std::size_t j = 0; j < goals.size(); j++) {
+        if (!maze.isValidPosition(goals[j])) continue;
+        goalCells[j] = maze.toIndex(goals[j]);
+        if (!isGoal[goalCells[j]]) {
+            isGoal[goalCells[j]] = 1;
+            distinctGoals++;
+        }
+    }
+
+    if (static_cast<int>(gCost.size()) < cellCount) {
+        gCost.resize(cellCount);
+    }
+
+    for (std::size_t i = 0; i < origins.size(); i++) {
+        if (!maze.isValidPosition(origins[i])) continue;
+        int origin = maze.toIndex(origins[i]);
+
+        beginSearch(cellCount);
+        if (maze.isRectangularGrid()) {
+            result.visitedNodes += batchBfsSearch(origin, isGoal, distinctGoals,
+                [&maze](int index, int* out) { return maze.getGridNeighborIndices(index, out); });
+        } else {
+            result.visitedNodes += batchBfsSearch(origin, isGoal, distinctGoals,
+                [&maze](int index, int* out) { return maze.getNeighborIndices(index, out); });
+        }
+
+        for (std::size_t j = 0; j < goals.size(); j++) {
+            int goal = goalCells[j];
+            if (goal < 0 || !isVisited(goal)) continue;
+
+            std::size_t slot = swapped ? j * targets.size() + i : i * targets.size() + j;
+            result.distances[slot] = gCost[goal];
+            if (withPaths) {
+                std::vector<Point> path = buildPathFromParents(maze, origin, goal);
+                if (swapped) {
+                    std::reverse(path.begin(), path.end());
+                }
+                result.paths[slot] = std::move(path);
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    result.searchTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+    return result;
+}
+
+template <typename NeighborFn>
+double PathFinder::bitParallelBfs(int cellCount, const int* origins, int laneCount,
+                                std::vector<int>* const* out, NeighborFn neighbors) {
+    if (static_cast<int>(laneVisited.size()) < cellCount) {
+        laneVisited.assign(cellCount, 0);
+        laneFrontier.assign(cellCount, 0);
+        laneNext.assign(cellCount, 0);
+    }
+
+    laneCells.clear();
+    for (int k = 0; k < laneCount; k++) {
+        int cell = origins[k];
+        if (laneFrontier[cell] == 0) laneCells.push_back(cell);
+        laneFrontier[cell] |= 1ULL << k;
+        laneVisited[cell] |= 1ULL << k;
+        (*out[k])[cell] = 0;
+    }
+
+    // 统计"处理的前沿格子数"与"推进的(搜索, 格子)对数"，两者之比衡量前沿重叠的程度
+    std::int64_t frontierVisits = 0;
+    std::int64_t laneSteps = laneCount;
+
+    int adjacent[NeighborList::CAPACITY];
+    for (int level = 1; !laneCells.empty(); level++) {
+        frontierVisits += static_cast<std::int64_t>(laneCells.size());
+        // 推送：把每个前沿格子的位传给尚未被这些搜索访问过的邻居
+        laneNextCells.clear();
+        for (int cell : laneCells) {
+            std::uint64_t active = laneFrontier[cell];
+            int count = neighbors(cell, adjacent);
+            for (int k = 0; k < count; k++) {
+                int next = adjacent[k];
+                std::uint64_t added = active & ~laneVisited[next];
+                if (added) {
+                    if (laneNext[next] == 0) laneNextCells.push_back(next);
+                    laneNext[next] |= added;
+                }
+            }
+        }
+        for (int cell : laneCells) {
+            laneFrontier[cell] = 0;
+        }
+
+        // 新到达的位成为下一层前沿，并记录对应搜索的距离
+        for (int cell : laneNextCells) {
+            std::uint64_t bits = laneNext[cell];
+            laneNext[cell] = 0;
+            laneVisited[cell] |= bits;
+            laneFrontier[cell] = bits;
+            laneSteps += __builtin_popcountll(bits);
+            while (bits) {
+                (*out[__builtin_ctzll(bits)])[cell] = level;
+                bits &= bits - 1;
+            }
+        }
+        laneCells.swap(laneNextCells);
+    }
+
+    std::fill(laneVisited.begin(), laneVisited.begin() + cellCount, 0);
+    return frontierVisits > 0 ? static_cast<double>(laneSteps) / frontierVisits : LANES;
+}
+
+std::vector<std::vector<int>> PathFinder::multiSourceDistances(const Maze& maze, const std::vector<Point>& sources,
+                                                               bool bitParallel) {
+    int cellCount = maze.getCellCount();
+    std::vector<std::vector<int>> distances(sources.size());
+    std::vector<int> origins;
+    std::vector<std::vector<int>*> outputs;
+    std::vector<std::uint64_t> locality;
+    for (std::size_t i = 0; i < sources.size(); i++) {
+        distances[i].assign(cellCount, -1);
+        if (maze.isValidPosition(sources[i])) {
+            origins.push_back(maze.toIndex(sources[i]));
+            outputs.push_back(&distances[i]);
+            locality.push_back(maze.isRectangularGrid() ? interleaveBits(sources[i].x, sources[i].y)
+                                                        : static_cast<std::uint64_t>(origins.back()));
+        }
+    }
+
+    // 按空间位置（矩形网格用Z序）排序，让同一组的起点尽量靠近：
+    // 它们到远处格子的距离相近，各自的前沿才会落在同一批格子上
+    std::vector<int> order(origins.size());
+    for (std::size_t i = 0; i < order.size(); i++) order[i] = static_cast<int>(i);
+    std::sort(order.begin(), order.end(), [&locality](int a, int b) { return locality[a] < locality[b]; });
+
+    std::vector<char> noGoals;
+    bool useBits = bitParallel;
+    std::vector<int> laneOrigins;
+    std::vector<std::vector<int>*> laneOutputs;
+    for (std::size_t next = 0; next < order.size(); ) {
+        std::size_t remaining = order.size() - next;
+        if (useBits && remaining >= static_cast<std::size_t>(BIT_PARALLEL_MIN_SOURCES)) {
+            int laneCount = static_cast<int>(std::min<std::size_t>(LANES, remaining));
+            laneOrigins.clear();
+            laneOutputs.clear();
+            for (int k = 0; k < laneCount; k++) {
+                laneOrigins.push_back(origins[order[next + k]]);
+                laneOutputs.push_back(outputs[order[next + k]]);
+            }
+            double sharing;
+            if (maze.isRectangularGrid()) {
+                sharing = bitParallelBfs(cellCount, laneOrigins.data(), laneCount, laneOutputs.data(),
+                    [&maze](int index, int* out) { return maze.getGridNeighborIndices(index, out); });
+            } else {
+                sharing = bitParallelBfs(cellCount, laneOrigins.data(), laneCount, laneOutputs.data(),
+                    [&maze](int index, int* out) { return maze.getNeighborIndices(index, out); });
+            }
+            // 前沿几乎不重叠时（起点分散、走廊很长）位并行比普通BFS还慢，剩下的起点改为逐个求解
+            if (sharing < MIN_LANE_SHARING) useBits = false;
+            next += laneCount;
+            continue;
+        }
+
+        // 逐个起点做完整的BFS（没有目标，遍历整个连通区域）
+        if (noGoals.empty()) {
+            noGoals.assign(cellCount, 0);
+            if (static_cast<int>(gCost.size()) < cellCount) {
+                gCost.resize(cellCount);
+            }
+        }
+        int origin = origins[order[next]];
+        beginSearch(cellCount);
+        if (maze.isRectangularGrid()) {
+            batchBfsSearch(origin, noGoals, INT_MAX,
+                [&maze](int index, int* out) { return maze.getGridNeighborIndices(index, out); });
+        } else {
+            batchBfsSearch(origin, noGoals, INT_MAX,
+                [&maze](int index, int* out) { return maze.getNeighborIndices(index, out); });
+        }
+        std::vector<int>& out = *outputs[order[next]];
+        for (int c = 0; c < cellCount; c++) {
+            if (isVisited(c)) out[c] = gCost[c];
+        }
+        next++;
+    }
+    return distances;
+}
@@ -0,0 +1,280 @@
+#include "pathfinder.h"
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+
+/**
+ * 双向搜索的实现
+ * 1. 正向一侧复用visitMark/gCost/parentIndex/frontier/openHeap，
+ *    反向一侧使用backward*缓冲区，两侧共用同一个访问标记计数器
+ * 2. 迷宫的通行关系是对称的，反向搜索与正向搜索使用同一个邻居函数
+ * 3. 每当一侧扩展到另一侧已到达的格子，就用两侧代价之和更新已知最短路径
+ */
+
+void PathFinder::beginBackwardSearch(int cellCount) {
+    if (static_cast<int>(backwardMark.size()) < cellCount) {
+        // 旧标记都小于currentMark，新增部分置0即可
+        backwardMark.resize(cellCount, 0);
+    }
+    if (static_cast<int>(gCost.size()) < cellCount) {
+        gCost.resize(cellCount);
+    }
+    if (static_cast<int>(backwardCost.size()) < cellCount) {
+        backwardCost.resize(cellCount);
+        backwardParent.resize(cellCount);
+    }
+    backwardFrontier.clear();
+}
+
+std::vector<Point> PathFinder::buildBidirectionalPath(const Maze& maze, int source, int target,
+                                                      int meetFrom, int meetTo) const {
+    std::vector<Point> path = buildPathFromParents(maze, source, meetFrom);
+    for (int cur = meetTo; ; cur = backwardParent[cur]) {
+        if (cur != meetFrom) {
+            path.push_back(maze.fromIndex(cur));
+        }
+        if (cur == target) break;
+    }
+    return path;
+}
+
+PathFinder::SearchResult PathFinder::findPathBidirectionalBFS(Maze& maze) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    SearchResult result;
+    result.algorithm = "双向BFS";
+
+    Point entrance = maze.getEntrance();
+    Point exit = maze.getExit();
+    if (!maze.isValidPosition(entrance) || !maze.isValidPosition(exit)) {
+        return result;
+    }
+
+    int cellCount = maze.getCellCount();
+    beginSearch(cellCount);
+    beginBackwardSearch(cellCount);
+    int source = maze.toIndex(entrance);
+    int target = maze.toIndex(exit);
+
+    int meetFrom, meetTo;
+    int visitedCount;
+    if (maze.isRectangularGrid()) {
+        visitedCount = bidirectionalBfsSearch(source, target,
+            [&maze](int index, int* out) { return maze.getGridNeighborIndices(index, out); }, meetFrom, meetTo);
+    } else {
+        visitedCount = bidirectionalBfsSearch(source, target,
+            [&maze](int index, int* out) { return maze.getNeighborIndices(index, out); }, meetFrom, meetTo);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    result.found = (meetFrom >= 0);
+    result.visitedNodes = visitedCount;
+    result.searchTime = duration.count() / 1000.0;
+
+    if (result.found) {
+        result.path = buildBidirectionalPath(maze, source, target, meetFrom, meetTo);
+        result.steps = result.path.size() - 1;
+    }
+
+    return result;
+}
+
+template <typename NeighborFn>
+int PathFinder::bidirectionalBfsSearch(int source, int target, NeighborFn neighbors, int& meetFrom, int& meetTo) {
+    meetFrom = meetTo = -1;
+
+    markVisited(source);
+    gCost[source] = 0;
+    parentIndex[source] = source;
+    if (source == target) {
+        meetFrom = meetTo = source;
+        return 1;
+    }
+    frontier.push(source);
+
+    backwardMark[target] = currentMark;
+    backwardCost[target] = 0;
+    backwardParent[target] = target;
+    backwardFrontier.push(target);
+
+    int visitedCount = 2;
+    int best = INT_MAX;
+    int adjacent[NeighborList::CAPACITY];
+
+    // 扩展一侧的完整一层；遇到另一侧已到达的格子时更新最短路径
+    auto expandLayer = [&](RingQueue<int>& queue,
+                           std::vector<unsigned>& ownMark, std::vector<int>& ownCost, std::vector<int>& ownParent,
+                           const std::vector<unsigned>& otherMark, const std::vector<int>& otherCost,
+                           bool forward) {
+        for (int layer = queue.size(); layer > 0; layer--) {
+            int u = queue.pop();
+            int count = neighbors(u, adjacent);
+            for (int k = 0; k < count; k++) {
+                int v = adjacent[k];
+                if (otherMark[v] == currentMark) {
+                    int length = ownCost[u] + 1 + otherCost[v];
+                    if (length < best) {
+                        best = length;
+                        meetFrom = forward ? u : v;
+                        meetTo = forward ? v : u;
+                    }
+                }
+                if (ownMark[v] != currentMark) {
+                    ownMark[v] = currentMark;
+                    ownCost[v] = ownCost[u] + 1;
+                    ownParent[v] = u;
+                    queue.push(v);
+                    visitedCount++;
+                }
+            }
+        }
+    };
+
+    // 整层扩展完毕后，该层内找到的最短相遇路径就是全局最短路径
+    while (best == INT_MAX && !frontier.empty() && !backwardFrontier.empty()) {
+        if (frontier.size() <= backwardFrontier.size()) {
+            expandLayer(frontier, visitMark, gCost, parentIndex, backwardMark, backwardCost, true);
+        } else {
+            expandLayer(backwardFrontier, backwardMark, backwardCost, backwardParent, visitMark, gCost, false);
+        }
+    }
+    return visitedCount;
+}
+
+PathFinder::SearchResult PathFinder::findPathBidirectionalAStar(Maze& maze) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    SearchResult result;
+    result.algorithm = "双向A*";
+
+    Point entrance = maze.getEntrance();
+    Point exit = maze.getExit();
+    if (!maze.isValidPosition(entrance) || !maze.isValidPosition(exit)) {
+        return result;
+    }
+
+    int cellCount = maze.getCellCount();
+    beginSearch(cellCount);
+    beginBackwardSearch(cellCount);
+    openHeap.reserveIds(cellCount);
+    backwardHeap.reserveIds(cellCount);
+    int source = maze.toIndex(entrance);
+    int target = maze.toIndex(exit);
+
+    int meetFrom, meetTo;
+    int visitedCount;
+    if (maze.isRectangularGrid()) {
+        int cols = maze.getCols();
+        auto manhattanTo = [cols](const Point& goal) {
+            return [cols, goal](int index) {
+                int x = index / cols;
+                return std::abs(x - goal.x) + std::abs(index - x * cols - goal.y);
+            };
+        };
+        visitedCount = bidirectionalAStarSearch(source, target,
+            [&maze](int index, int* out) { return maze.getGridNeighborIndices(index, out); },
+            manhattanTo(exit), manhattanTo(entrance), meetFrom, meetTo);
+    } else {
+        visitedCount = bidirectionalAStarSearch(source, target,
+            [&maze](int index, int* out) { return maze.getNeighborIndices(index, out); },
+            [&maze, target](int index) { return maze.getDistanceLowerBound(index, target); },
+            [&maze, source](int index) { return maze.getDistanceLowerBound(index, source); },
+            meetFrom, meetTo);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    result.found = (meetFrom >= 0);
+    result.visitedNodes = visitedCount;
+    result.searchTime = duration.count() / 1000.0;
+
+    if (result.found) {
+        result.path = buildBidirectionalPath(maze, source, target, meetFrom, meetTo);
+        result.steps = result.path.size() - 1;
+    }
+
+    return result;
+}
+
+template <typename NeighborFn, typename ForwardHeuristicFn, typename BackwardHeuristicFn>
+int PathFinder::bidirectionalAStarSearch(int source, int target, NeighborFn neighbors,
+                                         ForwardHeuristicFn forwardHeuristic, BackwardHeuristicFn backwardHeuristic,
+                                         int& meetFrom, int& meetTo) {
+    // 堆键值与findPathAStar相同：高32位为f，低32位为h
+    auto makeKey = [](int g, int h) {
+        return (static_cast<std::int64_t>(g + h) << 32) | static_cast<std::uint32_t>(h);
+    };
+
+    meetFrom = meetTo = -1;
+    if (source == target) {
+        parentIndex[source] = source;
+        meetFrom = meetTo = source;
+        return 1;
+    }
+
+    markVisited(source);
+    gCost[source] = 0;
+    parentIndex[source] = source;
+    openHeap.pushOrDecrease(source, makeKey(0, forwardHeuristic(source)));
+
+    backwardMark[target] = currentMark;
+    backwardCost[target] = 0;
+    backwardParent[target] = target;
+    backwardHeap.pushOrDecrease(target, makeKey(0, backwardHeuristic(target)));
+
+    int visitedCount = 0;
+    int best = INT_MAX;
+    int adjacent[NeighborList::CAPACITY];
+
+    // 从一侧的开放列表弹出一个格子并松弛其邻居
+    auto expandOne = [&](IndexedHeap& heap, auto& heuristic,
+                         std::vector<unsigned>& ownMark, std::vector<int>& ownCost, std::vector<int>& ownParent,
+                         const std::vector<unsigned>& otherMark, const std::vector<int>& otherCost,
+                         bool forward) {
+        int u = heap.pop();
+        visitedCount++;
+        int newCost = ownCost[u] + 1;
+        int count = neighbors(u, adjacent);
+        for (int k = 0; k < count; k++) {
+            int v = adjacent[k];
+            if (otherMark[v] == currentMark && newCost + otherCost[v] < best) {
+                best = newCost + otherCost[v];
+                meetFrom = forward ? u : v;
+                meetTo = forward ? v : u;
+            }
+            if (ownMark[v] != currentMark) {
+                ownMark[v] = currentMark;
+                ownCost[v] = newCost;
+                ownParent[v] = u;
+                heap.pushOrDecrease(v, makeKey(newCost, heuristic(v)));
+            } else if (heap.contains(v) && newCost < ownCost[v]) {
+                ownCost[v] = newCost;
+                ownParent[v] = u;
+                heap.pushOrDecrease(v, makeKey(newCost, heuristic(v)));
+            }
+        }
+    };
+
+    // 启发式一致时，任一侧开放列表的最小f值都是尚未找到的路径长度的下界；
+    // 两个下界中较大者不小于best时，best即为最短路径长度
+    while (!openHeap.empty() && !backwardHeap.empty()) {
+        int forwardBound = static_cast<int>(openHeap.topKey() >> 32);
+        int backwardBound = static_cast<int>(backwardHeap.topKey() >> 32);
+        if (std::max(forwardBound, backwardBound) >= best) break;
+
+        // 优先扩展开放列表较小的一侧
+        if (openHeap.size() <= backwardHeap.size()) {
+            expandOne(openHeap, forwardHeuristic, visitMark, gCost, parentIndex, backwardMark, backwardCost, true);
+        } else {
+            expandOne(backwardHeap, backwardHeuristic, backwardMark, backwardCost, backwardParent,
+                      visitMark, gCost, false);
+        }
+    }
+
+    openHeap.clear();
+    backwardHeap.clear();
+    return visitedCount;
+}
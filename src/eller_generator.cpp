@@ -0,0 +1,143 @@
+#include "eller_generator.h"
+#include <ostream>
+#include <string>
+
+/**
+ * Eller算法的实现
+ * 每行的集合编号在行首压缩到 [0, cols)，所以本行的并查集、计数数组都只需要cols个元素，
+ * 每行的工作量是O(cols)，与已经生成的行数无关
+ */
+
+namespace {
+
+void clearBit(std::uint64_t* bits, int y) {
+    bits[y >> 6] &= ~(std::uint64_t(1) << (y & 63));
+}
+
+bool testBit(const std::uint64_t* bits, int y) {
+    return (bits[y >> 6] >> (y & 63)) & 1;
+}
+
+} // namespace
+
+EllerGenerator::EllerGenerator(int cols, std::uint64_t seed)
+    : cols(cols), wordsPerRow((static_cast<std::size_t>(cols) + 63) / 64), rng(seed),
+      setOf(cols, -1), parent(cols), remap(cols), members(cols), chosen(cols), opened(cols) {}
+
+int EllerGenerator::find(int label) {
+    while (parent[label] != label) {
+        parent[label] = parent[parent[label]];
+        label = parent[label];
+    }
+    return label;
+}
+
+void EllerGenerator::nextRow(std::uint64_t* rightWalls, std::uint64_t* bottomWalls, bool lastRow) {
+    for (std::size_t w = 0; w < wordsPerRow; w++) {
+        rightWalls[w] = ~std::uint64_t(0);
+        bottomWalls[w] = ~std::uint64_t(0);
+    }
+
+    // 上一行没有向下打通的格子各自成为一个新集合
+    for (int j = 0; j < cols; j++) {
+        if (setOf[j] < 0) setOf[j] = labelCount++;
+        parent[j] = j;
+    }
+
+    // 行内：随机拆除不同集合之间的右墙（最后一行全部拆除，把所有集合连起来）
+    for (int j = 0; j + 1 < cols; j++) {
+        int a = find(setOf[j]);
+        int b = find(setOf[j + 1]);
+        if (a != b && (lastRow || coins.next(rng))) {
+            parent[b] = a;
+            clearBit(rightWalls, j);
+        }
+    }
+    rowsGenerated++;
+    if (lastRow) return;
+
+    // 向下：每格随机打通，之后没有打通的集合用蓄水池抽样随机选一个格子打通
+    for (int j = 0; j < cols; j++) {
+        opened[j] = 0;
+        members[j] = 0;
+    }
+    for (int j = 0; j < cols; j++) {
+        int label = find(setOf[j]);
+        setOf[j] = label;
+        if (coins.next(rng)) {
+            clearBit(bottomWalls, j);
+            opened[label] = 1;
+        }
+    }
+    for (int j = 0; j < cols; j++) {
+        int label = setOf[j];
+        if (opened[label]) continue;
+        members[label]++;
+        if (rng.below(static_cast<std::uint32_t>(members[label])) == 0) chosen[label] = j;
+    }
+    for (int j = 0; j < cols; j++) {
+        int label = setOf[j];
+        if (!opened[label]) {
+            clearBit(bottomWalls, chosen[label]);
+            opened[label] = 1;
+        }
+    }
+
+    // 下一行：向下打通的格子继承集合（编号压缩到 [0, cols)），其余格子等待新编号
+    for (int j = 0; j < cols; j++) {
+        remap[j] = -1;
+    }
+    labelCount = 0;
+    for (int j = 0; j < cols; j++) {
+        if (testBit(bottomWalls, j)) {
+            setOf[j] = -1;
+            continue;
+        }
+        int& label = remap[setOf[j]];
+        if (label < 0) label = labelCount++;
+        setOf[j] = label;
+    }
+}
+
+long long EllerGenerator::writeText(std::ostream& out, long long rows, int cols, std::uint64_t seed) {
+    if (rows <= 0 || cols <= 0) return 0;
+
+    EllerGenerator generator(cols, seed);
+    std::vector<std::uint64_t> rightWalls(generator.getWordsPerRow());
+    std::vector<std::uint64_t> bottomWalls(generator.getWordsPerRow());
+
+    std::string line;
+    line.reserve(static_cast<std::size_t>(cols) * 3 + 2);
+    line = "+";
+    for (int j = 0; j < cols; j++) line += "--+";
+    line += '\n';
+    out << line;
+
+    for (long long x = 0; x < rows; x++) {
+        generator.nextRow(rightWalls.data(), bottomWalls.data(), x == rows - 1);
+
+        line = "|";
+        for (int j = 0; j < cols; j++) {
+            if (x == 0 && j == 0) line += "S ";
+            else if (x == rows - 1 && j == cols - 1) line += "E ";
+            else line += "  ";
+            line += testBit(rightWalls.data(), j) ? '|' : ' ';
+        }
+        line += '\n';
+        out << line;
+
+        line = "+";
+        for (int j = 0; j < cols; j++) {
+            line += testBit(bottomWalls.data(), j) ? "--+" : "  +";
+        }
+        line += '\n';
+        out << line;
+        if (!out) return x;
+    }
+    return rows;
+}
+
+std::size_t EllerGenerator::memoryBytes() const {
+    return (setOf.capacity() + parent.capacity() + remap.capacity() + members.capacity() + chosen.capacity()) * sizeof(int)
+           + opened.capacity();
+}
@@ -0,0 +1,94 @@
+#include "file_sink.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/**
+ * 输出文件的实现
+ */
+
+FileSink::FileSink(const std::string& filename, std::size_t bufferSize)
+    : fd(open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)),
+      buffer(bufferSize > 0 ? bufferSize : 1) {
+    setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+FileSink::~FileSink() {
+    close();
+}
+
+bool FileSink::close() {
+    if (fd < 0) return false;
+    drain();
+    if (::close(fd) != 0) failed = true;
+    fd = -1;
+    return !failed;
+}
+
+FileSink::int_type FileSink::overflow(int_type ch) {
+    if (!drain()) return traits_type::eof();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize FileSink::xsputn(const char* data, std::streamsize length) {
+    std::size_t n = static_cast<std::size_t>(length);
+    std::size_t space = static_cast<std::size_t>(epptr() - pptr());
+    if (n <= space) {
+        std::memcpy(pptr(), data, n);
+        pbump(static_cast<int>(n));
+        return length;
+    }
+    // 放不进缓冲区：大块数据与缓冲区一起直接写出，小块数据先腾出缓冲区再复制
+    if (n >= buffer.size()) {
+        return drain(data, n) ? length : 0;
+    }
+    if (!drain()) return 0;
+    std::memcpy(pptr(), data, n);
+    pbump(static_cast<int>(n));
+    return length;
+}
+
+int FileSink::sync() {
+    return drain() ? 0 : -1;
+}
+
+bool FileSink::drain(const char* extra, std::size_t extraLength) {
+    iovec parts[2];
+    parts[0].iov_base = pbase();
+    parts[0].iov_len = static_cast<std::size_t>(pptr() - pbase());
+    parts[1].iov_base = const_cast<char*>(extra);
+    parts[1].iov_len = extraLength;
+    setp(buffer.data(), buffer.data() + buffer.size());
+    if (fd < 0 || failed) {
+        failed = true;
+        return false;
+    }
+
+    // writev可能只写出一部分，调整剩余的部分后继续
+    int first = 0;
+    while (first < 2 && parts[first].iov_len == 0) first++;
+    while (first < 2) {
+        ssize_t written = writev(fd, parts + first, 2 - first);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            failed = true;
+            return false;
+        }
+        std::size_t remaining = static_cast<std::size_t>(written);
+        while (first < 2 && remaining >= parts[first].iov_len) {
+            remaining -= parts[first].iov_len;
+            first++;
+        }
+        if (first < 2) {
+            parts[first].iov_base = static_cast<char*>(parts[first].iov_base) + remaining;
+            parts[first].iov_len -= remaining;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,445 @@
+#include "job_server.h"
+#include <cctype>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * 作业服务器的实现
+ * 只解析扁平的JSON对象：值可以是字符串、数字、true/false/null或由它们组成的数组（转换成逗号分隔的列表）
+ */
+
+// 一个输入流（标准输入或一个套接字连接）的状态：限制同时执行的作业数，串行写回结果
+struct JobServer::Channel {
+    std::mutex mutex;
+    std::condition_variable changed;
+    int inFlight = 0;
+    int failed = 0;
+    std::function<void(const std::string&)> write;    // 调用时已持有mutex
+
+    void acquire(int limit) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return inFlight < limit; });
+        inFlight++;
+    }
+
+    void send(const std::string& text, bool ok, bool release) {
+        std::lock_guard<std::mutex> lock(mutex);
+        write(text);
+        if (!ok) failed++;
+        if (release) {
+            inFlight--;
+            changed.notify_all();
+        }
+    }
+
+    void drain() {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return inFlight == 0; });
+    }
+};
+
+namespace {
+
+void skipSpace(const std::string& text, std::size_t& pos) {
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\r' || text[pos] == '\n')) pos++;
+}
+
+void appendUtf8(std::string& out, unsigned code) {
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+// pos指向开头的引号，结束时指向结尾引号之后
+bool parseString(const std::string& text, std::size_t& pos, std::string& out) {
+    pos++;
+    while (pos < text.size()) {
+        char c = text[pos++];
+        if (c == '"') return true;
+        if (c != '\\') {
+            out += c;
+            continue;
+        }
+        if (pos >= text.size()) return false;
+        char escape = text[pos++];
+        switch (escape) {
+            case '"': case '\\': case '/': out += escape; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                if (pos + 4 > text.size()) return false;
+                char* end = nullptr;
+                std::string hex = text.substr(pos, 4);
+                unsigned code = static_cast<unsigned>(std::strtoul(hex.c_str(), &end, 16));
+                if (*end != '\0') return false;
+                appendUtf8(out, code);
+                pos += 4;
+                break;
+            }
+            default: return false;
+        }
+    }
+    return false;
+}
+
+// 是否符合JSON数字的语法：-?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+bool isJsonNumber(const std::string& text) {
+    std::size_t pos = 0;
+    auto digits = [&] {
+        std::size_t start = pos;
+        while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) pos++;
+        return pos > start;
+    };
+    if (pos < text.size() && text[pos] == '-') pos++;
+    if (pos < text.size() && text[pos] == '0') pos++;
+    else if (!digits()) return false;
+    if (pos < text.size() && text[pos] == '.') {
+        pos++;
+        if (!digits()) return false;
+    }
+    if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+        pos++;
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) pos++;
+        if (!digits()) return false;
+    }
+    return pos == text.size();
+}
+
+// 解析一个标量：字符串去掉引号，数字和true/false/null保持原样；raw为值在原文中的JSON文本
+// 不带引号的值只接受JSON数字和true/false/null，其他单词视为格式错误
+bool parseScalar(const std::string& text, std::size_t& pos, std::string& value, std::string& raw) {
+    std::size_t start = pos;
+    if (pos < text.size() && text[pos] == '"') {
+        if (!parseString(text, pos, value)) return false;
+    } else {
+        while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) ||
+                                     text[pos] == '-' || text[pos] == '+' || text[pos] == '.')) {
+            value += text[pos++];
+        }
+        if (value != "true" && value != "false" && value != "null" && !isJsonNumber(value)) return false;
+    }
+    raw = text.substr(start, pos - start);
+    return true;
+}
+
+bool parseValue(const std::string& text, std::size_t& pos, std::string& value, std::string& raw) {
+    if (pos >= text.size() || text[pos] != '[') return parseScalar(text, pos, value, raw);
+    std::size_t start = pos++;
+    skipSpace(text, pos);
+    if (pos < text.size() && text[pos] == ']') {
+        pos++;
+    } else {
+        while (true) {
+            std::string item, itemRaw;
+            skipSpace(text, pos);
+            if (!parseScalar(text, pos, item, itemRaw)) return false;
+            if (!value.empty()) value += ',';
+            value += item;
+            skipSpace(text, pos);
+            if (pos >= text.size()) return false;
+            if (text[pos++] == ']') break;
+            if (text[pos - 1] != ',') return false;
+        }
+    }
+    raw = text.substr(start, pos - start);
+    return true;
+}
+
+void appendJsonString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+                    out += buffer;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+bool sendAll(int fd, const std::string& text) {
+    std::size_t sent = 0;
+    while (sent < text.size()) {
+        ssize_t n = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        sent += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+JobServer::JobServer(int threadCount)
+    : pool((threadCount <= 0 ? ThreadPool::hardwareThreads() : threadCount) + 1) {
+    // 线程池的调用者线程（编号0）不执行submit的任务，工作线程恰好为threadCount个
+    runners.resize(pool.size());
+    for (auto& runner : runners) {
+        runner.reset(new BatchRunner());
+    }
+    maxInFlight = 4 * getThreadCount();
+}
+
+bool JobServer::parseRequest(const std::string& line, Request& request, std::string& error) {
+    request.id = "null";
+    request.op = "solve";
+    std::size_t pos = 0;
+    skipSpace(line, pos);
+    if (pos >= line.size() || line[pos++] != '{') {
+        error = "作业必须是一个JSON对象";
+        return false;
+    }
+
+    // 先解析全部字段，id即使出现在出错的字段之后也能回显
+    std::vector<std::pair<std::string, std::string>> fields;
+    skipSpace(line, pos);
+    bool closed = pos < line.size() && line[pos] == '}';
+    if (closed) pos++;
+    while (!closed) {
+        std::string key, value, raw;
+        skipSpace(line, pos);
+        if (pos >= line.size() || line[pos] != '"' || !parseString(line, pos, key)) {
+            error = "JSON字段名无效";
+            return false;
+        }
+        skipSpace(line, pos);
+        if (pos >= line.size() || line[pos++] != ':') {
+            error = "JSON字段缺少冒号: " + key;
+            return false;
+        }
+        skipSpace(line, pos);
+        if (!parseValue(line, pos, value, raw)) {
+            error = "JSON字段值无效: " + key;
+            return false;
+        }
+        if (key == "id") {
+            // id原样回显在结果中，只接受字符串和数字；字符串重新转义，保证回显的是合法JSON
+            if (raw[0] == '"') {
+                request.id.clear();
+                appendJsonString(request.id, value);
+            } else if (isJsonNumber(raw)) {
+                request.id = raw;
+            } else {
+                error = "id 必须是字符串或数字";
+                return false;
+            }
+        }
+        else if (key == "op") request.op = value;
+        else fields.emplace_back(key, value);
+        skipSpace(line, pos);
+        if (pos >= line.size()) {
+            error = "JSON对象没有结束";
+            return false;
+        }
+        char c = line[pos++];
+        if (c == '}') closed = true;
+        else if (c != ',') {
+            error = "JSON对象格式错误";
+            return false;
+        }
+    }
+
+    for (const auto& field : fields) {
+        if (!request.spec.set(field.first, field.second, error)) return false;
+    }
+    if (request.spec.repeat != 1) {
+        error = "服务器模式不支持repeat，请发送多个作业";
+        return false;
+    }
+    // 尺寸等跨字段的检查在分派之前完成，出错的作业不占用工作线程
+    if (!request.spec.validate(error)) return false;
+
+    JobSpec& spec = request.spec;
+    if (request.op == "generate") {
+        spec.solvers.clear();
+        spec.exportFormat.clear();
+    } else if (request.op == "solve") {
+        if (spec.solvers.empty()) spec.solvers.push_back("bfs");
+    } else if (request.op == "compare") {
+        if (spec.solvers.size() < 2) spec.set("solvers", "all", error);
+    } else if (request.op == "export") {
+        if (spec.exportFormat.empty()) {
+            error = "export作业需要指定export格式";
+            return false;
+        }
+    } else {
+        error = "未知的操作: " + request.op;
+        return false;
+    }
+    return true;
+}
+
+std::string JobServer::errorLine(const std::string& id, const std::string& error) {
+    std::string line = "{\"id\":" + id + ",\"ok\":false,\"error\":";
+    appendJsonString(line, error);
+    line += "}\n";
+    return line;
+}
+
+std::string JobServer::execute(const Request& request, bool& ok) {
+    BatchRunner& runner = *runners[ThreadPool::currentWorker()];
+    const JobSpec& spec = request.spec;
+    JobResult result;
+    ok = runner.execute(spec, spec.seed != 0 ? spec.seed : Xoshiro256::randomSeed(), result, request.number);
+    if (!ok) return errorLine(request.id, result.error);
+
+    std::ostringstream line;
+    line << "{\"id\":" << request.id << ",\"ok\":true,\"op\":\"" << request.op << "\",\"seed\":" << result.seed
+         << ",\"generate_ms\":" << result.generateTime << ",\"cached\":" << (result.cached ? "true" : "false");
+    if (spec.type == "mondrian") line << ",\"rooms\":" << result.rooms;
+    if (!result.solvers.empty()) {
+        line << ",\"solvers\":[";
+        const SolverStats* fastest = nullptr;
+        for (std::size_t i = 0; i < result.solvers.size(); i++) {
+            const SolverStats& solver = result.solvers[i];
+            line << (i ? "," : "") << "{\"name\":\"" << solver.name << "\",\"found\":" << (solver.found ? "true" : "false")
+                 << ",\"steps\":" << solver.steps << ",\"visited\":" << solver.visitedNodes << ",\"ms\":" << solver.searchTime << "}";
+            if (solver.found && (!fastest || solver.searchTime < fastest->searchTime)) fastest = &solver;
+        }
+        line << "]";
+        if (request.op == "compare" && fastest) line << ",\"fastest\":\"" << fastest->name << "\"";
+    }
+    if (!result.exportPath.empty()) {
+        std::string path;
+        appendJsonString(path, result.exportPath);
+        line << ",\"export\":" << path;
+    }
+    line << "}\n";
+    return line.str();
+}
+
+void JobServer::dispatch(const std::shared_ptr<Channel>& channel, const std::string& line) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) return;
+    Request request;
+    std::string error;
+    if (!parseRequest(line, request, error)) {
+        channel->send(errorLine(request.id, error), false, false);
+        return;
+    }
+    request.number = ++jobCounter;
+    channel->acquire(maxInFlight);
+    pool.submit([this, channel, request] {
+        bool ok = false;
+        std::string text;
+        try {
+            text = execute(request, ok);
+        } catch (const std::exception& e) {
+            text = errorLine(request.id, e.what());
+        } catch (...) {
+            // 任何异常都不能离开工作线程，否则整个服务器会被终止
+            text = errorLine(request.id, "执行作业时发生未知错误");
+        }
+        channel->send(text, ok, true);
+    });
+}
+
+int JobServer::serveStream(std::istream& in, std::ostream& out) {
+    auto channel = std::make_shared<Channel>();
+    channel->write = [&out](const std::string& text) {
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        out.flush();
+    };
+    std::string line;
+    while (std::getline(in, line)) {
+        dispatch(channel, line);
+    }
+    channel->drain();
+    return channel->failed;
+}
+
+void JobServer::serveConnection(int fd) {
+    auto channel = std::make_shared<Channel>();
+    channel->write = [fd](const std::string& text) { sendAll(fd, text); };
+
+    std::string pending;
+    char buffer[1 << 16];
+    while (true) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        pending.append(buffer, static_cast<std::size_t>(n));
+        std::size_t start = 0, newline;
+        while ((newline = pending.find('\n', start)) != std::string::npos) {
+            dispatch(channel, pending.substr(start, newline - start));
+            start = newline + 1;
+        }
+        pending.erase(0, start);
+    }
+    if (!pending.empty()) dispatch(channel, pending);
+
+    // 客户端关闭写端后仍把剩余结果写回，全部完成才关闭连接
+    channel->drain();
+    close(fd);
+}
+
+bool JobServer::serveSocket(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "套接字路径无效: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        std::perror("socket");
+        return false;
+    }
+    unlink(path.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+        std::cerr << "无法监听 " << path << ": " << std::strerror(errno) << std::endl;
+        close(listener);
+        return false;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+    std::cerr << "作业服务器已在 " << path << " 上监听，工作线程 " << getThreadCount() << " 个" << std::endl;
+
+    while (true) {
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            std::perror("accept");
+            break;
+        }
+        std::thread(&JobServer::serveConnection, this, fd).detach();
+    }
+    close(listener);
+    unlink(path.c_str());
+    return false;
+}
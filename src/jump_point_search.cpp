@@ -0,0 +1,203 @@
+#include "pathfinder.h"
+#include "jump_point_table.h"
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+
+/**
+ * 4连通跳点搜索（JPS+）
+ * 1. 搜索状态是(格子, 到达方向)：同一个格子从水平方向和竖直方向到达时可走的后继不同
+ * 2. 后继规则（见jump_point_table.h）：
+ *    起点向四个方向跳跃；水平到达后继续水平跳跃或转向上下；
+ *    竖直到达后继续竖直跳跃，只有强迫邻居所在的水平方向可以转向
+ * 3. 每次跳跃用跳点表O(1)得到落点，终点位于跳跃路线上时提前停在终点
+ * 4. 状态之间的代价是直线距离，曼哈顿距离仍是一致的启发式，A*不需要重新打开关闭的状态
+ */
+
+namespace {
+
+const int DX[4] = {-1, 0, 1, 0};   // 按WallDirection顺序：上、右、下、左
+const int DY[4] = {0, 1, 0, -1};
+
+inline bool isHorizontal(int dir) {
+    return dir == static_cast<int>(WallDirection::RIGHT) || dir == static_cast<int>(WallDirection::LEFT);
+}
+
+// 跳点表查询，附带终点判断
+struct JumpQuery {
+    const JumpPointTable& table;
+    int cols;
+    int goalX, goalY;
+
+    // 从(x, y)沿dir跳跃：返回落点格子编号并写入距离；沿途没有跳点也没有终点时返回-1
+    int jump(int x, int y, int dir, int& dist) const {
+        int value = table.jump(x * cols + y, dir);
+        int reach = std::abs(value);
+        int best = value > 0 ? value : INT_MAX;
+
+        if (isHorizontal(dir)) {
+            int ahead = (goalY - y) * DY[dir];
+            if (ahead > 0 && ahead <= reach && ahead < best) {
+                // 路线经过终点所在的列：终点在同一行，或从该列竖直走能到达终点
+                int rowGap = goalX - x;
+                if (rowGap == 0) {
+                    best = ahead;
+                } else {
+                    int vertical = rowGap > 0 ? static_cast<int>(WallDirection::BOTTOM)
+                                              : static_cast<int>(WallDirection::TOP);
+                    if (std::abs(rowGap) <= std::abs(table.jump(x * cols + goalY, vertical))) {
+                        best = ahead;
+                    }
+                }
+            }
+        } else if (goalY == y) {
+            int ahead = (goalX - x) * DX[dir];
+            if (ahead > 0 && ahead <= reach && ahead < best) {
+                best = ahead;
+            }
+        }
+
+        if (best == INT_MAX) return -1;
+        dist = best;
+        return (x + DX[dir] * best) * cols + (y + DY[dir] * best);
+    }
+};
+
+} // namespace
+
+PathFinder::SearchResult PathFinder::findPathJPS(Maze& maze) {
+    // 状态编号 = 格子编号 × 4 + 到达方向，用int表示；状态数按64位计算，避免大网格上溢出
+    std::int64_t stateCount = static_cast<std::int64_t>(maze.getCellCount()) * 4;
+    if (!maze.isRectangularGrid() || stateCount > INT_MAX) {
+        // 跳点规则依赖矩形网格的直线结构，其他迷宫和格子数超过INT_MAX/4的网格退化为A*
+        SearchResult result = findPathAStar(maze);
+        result.algorithm = "跳点搜索(JPS,退化为A*)";
+        return result;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    SearchResult result;
+    result.algorithm = "跳点搜索(JPS)";
+
+    Point entrance = maze.getEntrance();
+    Point exit = maze.getExit();
+    if (!maze.isValidPosition(entrance) || !maze.isValidPosition(exit)) {
+        return result;
+    }
+
+    std::shared_ptr<const JumpPointTable> table = maze.getJumpPointTable();
+    int cols = maze.getCols();
+    int source = maze.toIndex(entrance);
+    int target = maze.toIndex(exit);
+
+    beginSearch(static_cast<int>(stateCount));
+    if (static_cast<std::int64_t>(gCost.size()) < stateCount) {
+        gCost.resize(static_cast<std::size_t>(stateCount));
+    }
+    openHeap.reserveIds(static_cast<int>(stateCount));
+
+    JumpQuery query{*table, cols, exit.x, exit.y};
+    auto heuristic = [cols, &exit](int cell) {
+        int x = cell / cols;
+        return std::abs(x - exit.x) + std::abs(cell - x * cols - exit.y);
+    };
+    auto makeKey = [](int g, int h) {
+        return (static_cast<std::int64_t>(g + h) << 32) | static_cast<std::uint32_t>(h);
+    };
+
+    int startState = source * 4;
+    markVisited(startState);
+    gCost[startState] = 0;
+    parentIndex[startState] = startState;
+    openHeap.pushOrDecrease(startState, makeKey(0, heuristic(source)));
+
+    int visitedCount = 0;
+    int goalState = -1;
+
+    while (!openHeap.empty()) {
+        int state = openHeap.pop();
+        visitedCount++;
+
+        int cell = state >> 2;
+        if (cell == target) {
+            goalState = state;
+            break;
+        }
+
+        int x = cell / cols;
+        int y = cell - x * cols;
+        int arrived = state & 3;
+
+        // 按后继规则列出要跳跃的方向
+        int dirs[4];
+        int dirCount = 0;
+        if (state == startState) {
+            for (int d = 0; d < 4; d++) dirs[dirCount++] = d;
+        } else if (isHorizontal(arrived)) {
+            dirs[dirCount++] = arrived;
+            dirs[dirCount++] = static_cast<int>(WallDirection::TOP);
+            dirs[dirCount++] = static_cast<int>(WallDirection::BOTTOM);
+        } else {
+            dirs[dirCount++] = arrived;
+            // 强迫邻居：能向h移动，但从上一个格子"先h后竖直"的绕行走不通
+            int px = x - DX[arrived];
+            for (int h : {static_cast<int>(WallDirection::LEFT), static_cast<int>(WallDirection::RIGHT)}) {
+                if (!((maze.getOpenDirections(x, y) >> h) & 1u)) continue;
+                if (!((maze.getOpenDirections(px, y) >> h) & 1u) ||
+                    !((maze.getOpenDirections(px, y + DY[h]) >> arrived) & 1u)) {
+                    dirs[dirCount++] = h;
+                }
+            }
+        }
+
+        for (int k = 0; k < dirCount; k++) {
+            int dist;
+            int landing = query.jump(x, y, dirs[k], dist);
+            if (landing < 0) continue;
+
+            int next = landing * 4 + dirs[k];
+            int newGCost = gCost[state] + dist;
+            if (!isVisited(next)) {
+                markVisited(next);
+                gCost[next] = newGCost;
+                parentIndex[next] = state;
+                openHeap.pushOrDecrease(next, makeKey(newGCost, heuristic(landing)));
+            } else if (openHeap.contains(next) && newGCost < gCost[next]) {
+                gCost[next] = newGCost;
+                parentIndex[next] = state;
+                openHeap.pushOrDecrease(next, makeKey(newGCost, heuristic(landing)));
+            }
+        }
+    }
+    openHeap.clear();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    result.found = (goalState >= 0);
+    result.visitedNodes = visitedCount;
+    result.searchTime = duration.count() / 1000.0;
+
+    if (result.found) {
+        // 跳点之间都是直线，回溯时补全中间的格子
+        result.path.reserve(gCost[goalState] + 1);
+        for (int state = goalState; ; state = parentIndex[state]) {
+            Point p = maze.fromIndex(state >> 2);
+            if (!result.path.empty()) {
+                Point last = result.path.back();
+                int stepX = (p.x > last.x) - (p.x < last.x);
+                int stepY = (p.y > last.y) - (p.y < last.y);
+                for (Point q(last.x + stepX, last.y + stepY); q != p; q = Point(q.x + stepX, q.y + stepY)) {
+                    result.path.push_back(q);
+                }
+            }
+            result.path.push_back(p);
+            if (state == startState) break;
+        }
+        std::reverse(result.path.begin(), result.path.end());
+        result.steps = result.path.size() - 1;
+    }
+
+    return result;
+}
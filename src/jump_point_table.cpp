@@ -0,0 +1,79 @@
+#include "jump_point_table.h"
+#include "maze.h"
+
+/**
+ * 跳点表的构建
+ * 每个方向一次线性扫描：从该方向的尽头往回推，当前格子的值由下一个格子的值递推得到
+ */
+
+namespace {
+
+const int TOP = static_cast<int>(WallDirection::TOP);
+const int RIGHT = static_cast<int>(WallDirection::RIGHT);
+const int BOTTOM = static_cast<int>(WallDirection::BOTTOM);
+const int LEFT = static_cast<int>(WallDirection::LEFT);
+
+// 下一个格子的值为next时，当前格子（多走一步）的值
+inline std::int32_t extend(std::int32_t next) {
+    return next > 0 ? next + 1 : next - 1;
+}
+
+} // namespace
+
+JumpPointTable::JumpPointTable(const Maze& maze)
+    : rows(maze.getRows()), cols(maze.getCols()),
+      table(static_cast<std::size_t>(rows) * cols * 4, 0) {
+    // 先取出每个格子的开放方向掩码，之后的递推只读这张小表
+    std::vector<std::uint8_t> openMask(static_cast<std::size_t>(rows) * cols);
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            openMask[static_cast<std::size_t>(x) * cols + y] = static_cast<std::uint8_t>(maze.getOpenDirections(x, y));
+        }
+    }
+    auto open = [&](int x, int y, int dir) -> bool {
+        if (x < 0 || x >= rows || y < 0 || y >= cols) return false;
+        return (openMask[static_cast<std::size_t>(x) * cols + y] >> dir) & 1u;
+    };
+    auto at = [this](int x, int y, int dir) -> std::int32_t& {
+        return table[(static_cast<std::size_t>(x) * cols + y) * 4 + dir];
+    };
+    // 从(px, y)沿竖直方向v走到(x, y)后，水平方向h上是否有强迫邻居：
+    // 能向h移动，但"先h后v"的绕行走不通
+    auto forced = [&](int x, int y, int px, int v) {
+        for (int h : {LEFT, RIGHT}) {
+            if (!open(x, y, h)) continue;
+            int side = (h == LEFT) ? y - 1 : y + 1;
+            if (!open(px, y, h) || !open(px, side, v)) return true;
+        }
+        return false;
+    };
+
+    // 竖直方向：向下从最后一行往上推，向上从第0行往下推
+    for (int x = rows - 1; x >= 0; x--) {
+        for (int y = 0; y < cols; y++) {
+            if (!open(x, y, BOTTOM)) continue;
+            at(x, y, BOTTOM) = forced(x + 1, y, x, BOTTOM) ? 1 : extend(at(x + 1, y, BOTTOM));
+        }
+    }
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            if (!open(x, y, TOP)) continue;
+            at(x, y, TOP) = forced(x - 1, y, x, TOP) ? 1 : extend(at(x - 1, y, TOP));
+        }
+    }
+
+    // 水平方向：下一个格子的竖直跳跃能找到跳点时，它就是跳点
+    auto verticalHit = [&](int x, int y) {
+        return at(x, y, TOP) > 0 || at(x, y, BOTTOM) > 0;
+    };
+    for (int x = 0; x < rows; x++) {
+        for (int y = cols - 1; y >= 0; y--) {
+            if (!open(x, y, RIGHT)) continue;
+            at(x, y, RIGHT) = verticalHit(x, y + 1) ? 1 : extend(at(x, y + 1, RIGHT));
+        }
+        for (int y = 0; y < cols; y++) {
+            if (!open(x, y, LEFT)) continue;
+            at(x, y, LEFT) = verticalHit(x, y - 1) ? 1 : extend(at(x, y - 1, LEFT));
+        }
+    }
+}
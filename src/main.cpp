@@ -7,6 +7,18 @@
 #include <memory>
 #include "CircularMaze.h"
 #include "mondrian_maze.h"
+#include "routing_index.h"
+#include "reachability.h"
+#include "eller_generator.h"
+#include "maze_file.h"
+#include "batch_runner.h"
+#include "job_server.h"
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <climits>
+#include <algorithm>
+#include <cstdlib>
 
 /**
  * 主程序文件
@@ -22,6 +34,7 @@ private:
     std::unique_ptr<Maze> maze;
     PathFinder pathFinder;
     Visualizer visualizer;
+    SearchTrace searchTrace;    // 动画演示和热力图使用的搜索轨迹，多次演示之间复用缓冲区
     
 public:
     MazeApplication() : maze(nullptr), visualizer(Visualizer::COLORED, true, 50) {
@@ -76,6 +89,13 @@ public:
                 case 8:
                     mondrianMazeAdventure(visualizer);
                     break;
+                case 9:
+                    if (maze) {
+                        advancedAnalysisMenu();
+                    } else {
+                        std::cout << "请先创建迷宫！" << std::endl;
+                    }
+                    break;
                 case 0:
                     std::cout << "感谢使用迷宫寻路系统！" << std::endl;
                     break;
@@ -106,15 +126,18 @@ private:
         std::cout << "6. 演示模式" << std::endl;
         std::cout << "7. 帮助信息" << std::endl;
         std::cout << "8. 闯入蒙德里安名画" << std::endl;
+        std::cout << "9. 高级分析" << std::endl;
         std::cout << "0. 退出程序" << std::endl;
         std::cout << std::string(40, '=') << std::endl;
-        std::cout << "请选择操作 (0-8): ";
+        std::cout << "请选择操作 (0-9): ";
     }
     
     void createMaze() {
         std::cout << "\n--- 创建迷宫 ---\n";
         std::cout << "1. 创建矩形迷宫\n";
         std::cout << "2. 创建圆形迷宫\n";
+        std::cout << "3. 流式生成超大矩形迷宫到文件 (Eller，不占用整个迷宫的内存)\n";
+        std::cout << "4. 打开二进制迷宫文件 (内存映射)\n";
         std::cout << "请选择: ";
         int choice;
         std::cin >> choice;
@@ -128,14 +151,30 @@ private:
             std::cin >> cols;
             maze = std::make_unique<Maze>(rows, cols);
 
-            std::cout << "1. 随机墙壁生成\n2. DFS生成 (保证连通)\n请选择生成方式: ";
+            std::cout << "1. 随机墙壁生成\n2. DFS生成 (保证连通)\n3. 并行分块生成 (保证连通)\n"
+                      << "4. Kruskal生成 (保证连通)\n5. Eller逐行生成 (保证连通)\n请选择生成方式: ";
             int gen_choice;
             std::cin >> gen_choice;
+            std::uint64_t seed = readSeed();
+            maze->setSeed(seed);
             if (gen_choice == 1) {
                 double wallProb;
                 std::cout << "请输入墙壁移除概率 (0.0-1.0): ";
                 std::cin >> wallProb;
                 maze->generateRandomMaze(wallProb);
+            } else if (gen_choice == 3) {
+                auto start = std::chrono::high_resolution_clock::now();
+                maze->generateParallel(seed);
+                auto end = std::chrono::high_resolution_clock::now();
+                std::cout << "生成耗时: "
+                          << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0
+                          << " ms\n";
+            } else if (gen_choice == 4) {
+                maze->setGenerationAlgorithm(GenerationAlgorithm::KRUSKAL);
+                maze->generate();
+            } else if (gen_choice == 5) {
+                maze->setGenerationAlgorithm(GenerationAlgorithm::ELLER);
+                maze->generate();
             } else {
                 maze->generateWithDFS();
             }
@@ -146,17 +185,97 @@ private:
             int rings;
             std::cin >> rings;
             maze = std::make_unique<CircularMaze>(rings);
+            maze->setSeed(readSeed());
             maze->generate();
             std::cout << "圆形迷宫已生成!\n";
+        } else if (choice == 3) {
+            streamEllerMaze();
+            return;
+        } else if (choice == 4) {
+            openMazeFile();
+            return;
         }
         
         // 设置入口和出口
         setupEntranceAndExit();
         
-        std::cout << "迷宫创建成功！" << std::endl;
+        std::cout << "迷宫创建成功！随机种子: " << maze->getSeed() << "（输入同一种子可以复现）" << std::endl;
+        if (!maze->isExitReachable()) {
+            std::cout << "注意：当前迷宫从入口无法到达出口。" << std::endl;
+        }
         visualizer.displayMaze(*maze);
     }
     
+    // 读取随机种子，0表示随机选取
+    std::uint64_t readSeed() {
+        std::uint64_t seed;
+        std::cout << "请输入随机种子 (0表示随机): ";
+        std::cin >> seed;
+        return seed != 0 ? seed : Xoshiro256::randomSeed();
+    }
+
+    void streamEllerMaze() {
+        long long rows;
+        int cols;
+        std::uint64_t seed;
+        std::string filename;
+        std::cout << "请输入迷宫行数（可以超过内存容纳的规模）: ";
+        std::cin >> rows;
+        std::cout << "请输入迷宫列数: ";
+        std::cin >> cols;
+        seed = readSeed();
+        std::cout << "输出格式 1. 文本  2. 二进制迷宫文件（可用内存映射打开）: ";
+        int format;
+        std::cin >> format;
+        std::cout << "请输入输出文件名: ";
+        std::cin >> filename;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        long long written = 0;
+        if (format == 2) {
+            if (rows > INT_MAX) {
+                std::cout << "二进制迷宫文件的行数不能超过 " << INT_MAX << std::endl;
+                return;
+            }
+            if (!MazeFile::writeEller(filename, static_cast<int>(rows), cols, seed)) return;
+            written = rows;
+        } else {
+            std::ofstream file(filename);
+            if (!file) {
+                std::cout << "无法创建文件 " << filename << std::endl;
+                return;
+            }
+            written = EllerGenerator::writeText(file, rows, cols, seed);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "已写入 " << written << " 行到 " << filename << "，耗时 "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms"
+                  << "（生成器只保存一行状态，约 " << EllerGenerator(cols, seed).memoryBytes() << " 字节）" << std::endl;
+        std::cout << "流式生成的迷宫不会载入内存，当前迷宫保持不变。" << std::endl;
+    }
+
+    void openMazeFile() {
+        std::string filename;
+        std::cout << "请输入迷宫文件名: ";
+        std::cin >> filename;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::unique_ptr<Maze> mapped = MazeFile::map(filename);
+        auto end = std::chrono::high_resolution_clock::now();
+        if (!mapped) return;
+
+        maze = std::move(mapped);
+        MazeFile::Header header;
+        MazeFile::readHeader(filename, header);
+        std::cout << "已映射 " << maze->getRows() << "×" << maze->getCols() << " 的迷宫（"
+                  << maze->getStorage().memoryBytes() / (1024.0 * 1024.0) << " MB，种子 " << header.seed
+                  << "），耗时 " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0
+                  << " ms" << std::endl;
+        if (static_cast<long long>(maze->getRows()) * maze->getCols() <= 100 * 100) {
+            visualizer.displayMaze(*maze);
+        }
+    }
+
     void setupEntranceAndExit() {
         std::cout << "\n=== 设置入口和出口 ===" << std::endl;
         std::cout << "1. 使用默认位置 (左上角和右下角)" << std::endl;
@@ -222,28 +341,48 @@ private:
         std::cout << "2. 广度优先搜索 (BFS) - 最短路径" << std::endl;
         std::cout << "3. A*算法 - 启发式搜索" << std::endl;
         std::cout << "4. 找到所有路径" << std::endl;
-        std::cout << "请选择算法 (1-4): ";
+        std::cout << "5. 并行BFS - 多线程最短路径" << std::endl;
+        std::cout << "6. 双向BFS - 从入口和出口同时搜索" << std::endl;
+        std::cout << "7. 双向A*算法" << std::endl;
+        std::cout << "8. 跳点搜索 (JPS) - 适合开阔迷宫" << std::endl;
+        std::cout << "9. 树索引 - 完美迷宫直接查询" << std::endl;
+        std::cout << "请选择算法 (1-9): ";
         
         int choice;
         std::cin >> choice;
         
-        // 创建迷宫副本以保持原始状态
-        Maze mazeCopy = maze->clone();
+        // 求解算法不会修改迷宫，直接使用原迷宫（clone()会把圆形迷宫切片成矩形网格）
+        Maze& target = *maze;
         PathFinder::SearchResult result;
         
         switch (choice) {
             case 1:
-                result = pathFinder.findPathDFS(mazeCopy);
+                result = pathFinder.findPathDFS(target);
                 break;
             case 2:
-                result = pathFinder.findPathBFS(mazeCopy);
+                result = pathFinder.findPathBFS(target);
                 break;
             case 3:
-                result = pathFinder.findPathAStar(mazeCopy);
+                result = pathFinder.findPathAStar(target);
                 break;
             case 4:
                 findAllPathsDemo();
                 return;
+            case 5:
+                result = pathFinder.findPathParallelBFS(target);
+                break;
+            case 6:
+                result = pathFinder.findPathBidirectionalBFS(target);
+                break;
+            case 7:
+                result = pathFinder.findPathBidirectionalAStar(target);
+                break;
+            case 8:
+                result = pathFinder.findPathJPS(target);
+                break;
+            case 9:
+                result = pathFinder.findPathTree(target);
+                break;
             default:
                 std::cout << "无效选择！" << std::endl;
                 return;
@@ -266,15 +405,39 @@ private:
             std::cin >> animate;
             
             if (animate == 'y' || animate == 'Y') {
-                // 注意：这里需要重新搜索以获取搜索顺序
-                // 在实际实现中，可以修改PathFinder来返回搜索顺序
+                // 带轨迹重新搜索一次以获取扩展顺序（求解本身不记录，没有额外开销）
+                if (!traceSearch(target, choice)) {
+                    std::cout << "动画演示只支持DFS、BFS和A*算法。" << std::endl;
+                    return;
+                }
                 visualizer.setMode(Visualizer::ANIMATED);
-                std::cout << "动画演示功能需要算法返回搜索顺序，当前版本暂不支持。" << std::endl;
+                visualizer.animatePathFinding(target, searchTrace.expansionPoints(target), result.path);
                 visualizer.setMode(Visualizer::COLORED);
+                target.resetVisited();
+                
+                std::cout << "最大前沿: " << searchTrace.getMaxFrontier() << " 格" << std::endl;
+                if (target.isRectangularGrid()) {
+                    std::cout << "是否导出搜索热力图？(y/n): ";
+                    char heatmap;
+                    std::cin >> heatmap;
+                    if (heatmap == 'y' || heatmap == 'Y') {
+                        visualizer.exportHeatmapToHTML(target, searchTrace, result.path, "search_heatmap.html");
+                    }
+                }
             }
         }
     }
     
+    // 用菜单中的算法编号带轨迹重新搜索，结果在searchTrace中；算法不支持记录轨迹时返回false
+    bool traceSearch(Maze& target, int choice) {
+        switch (choice) {
+            case 1: pathFinder.findPathDFS(target, searchTrace); return true;
+            case 2: pathFinder.findPathBFS(target, searchTrace); return true;
+            case 3: pathFinder.findPathAStar(target, searchTrace); return true;
+            default: return false;
+        }
+    }
+    
     void findAllPathsDemo() {
         std::cout << "\n正在寻找所有可能路径..." << std::endl;
         
@@ -319,16 +482,23 @@ private:
         std::vector<PathFinder::SearchResult> results;
         
         // 测试DFS
-        Maze mazeCopy1 = maze->clone();
-        results.push_back(pathFinder.findPathDFS(mazeCopy1));
+        results.push_back(pathFinder.findPathDFS(*maze));
         
         // 测试BFS
-        Maze mazeCopy2 = maze->clone();
-        results.push_back(pathFinder.findPathBFS(mazeCopy2));
+        results.push_back(pathFinder.findPathBFS(*maze));
         
         // 测试A*
-        Maze mazeCopy3 = maze->clone();
-        results.push_back(pathFinder.findPathAStar(mazeCopy3));
+        results.push_back(pathFinder.findPathAStar(*maze));
+        
+        // 测试双向BFS和双向A*
+        results.push_back(pathFinder.findPathBidirectionalBFS(*maze));
+        results.push_back(pathFinder.findPathBidirectionalAStar(*maze));
+        
+        // 测试跳点搜索
+        results.push_back(pathFinder.findPathJPS(*maze));
+        
+        // 测试树索引（非完美迷宫时退化为BFS）
+        results.push_back(pathFinder.findPathTree(*maze));
         
         // 显示比较结果
         visualizer.displayComparison(results);
@@ -358,7 +528,8 @@ private:
         std::cout << "1. 导出迷宫到文本文件" << std::endl;
         std::cout << "2. 生成HTML可视化文件" << std::endl;
         std::cout << "3. 导出最短路径" << std::endl;
-        std::cout << "请选择 (1-3): ";
+        std::cout << "4. 保存为二进制迷宫文件" << std::endl;
+        std::cout << "请选择 (1-4): ";
         
         int choice;
         std::cin >> choice;
@@ -397,6 +568,11 @@ private:
                 }
                 break;
             }
+            case 4:
+                if (MazeFile::save(*maze, filename + ".maze")) {
+                    std::cout << "迷宫已保存到 " << filename << ".maze" << std::endl;
+                }
+                break;
             default:
                 std::cout << "无效选择！" << std::endl;
                 break;
@@ -431,8 +607,254 @@ private:
         }
     }
 
+    void advancedAnalysisMenu() {
+        std::cout << "\n=== 高级分析 ===" << std::endl;
+        std::cout << "1. 路由索引 - 大量随机查询与逐次BFS对比（完美迷宫同时比较树索引）" << std::endl;
+        std::cout << "2. 批量求解 - 多个入口到多个出口的距离矩阵" << std::endl;
+        std::cout << "3. 位并行BFS - 64个起点的离心率统计" << std::endl;
+        std::cout << "4. 可达性分析 - 位行泛洪填充与逐格泛洪对比" << std::endl;
+        std::cout << "请选择 (1-4): ";
+
+        int choice;
+        std::cin >> choice;
+
+        switch (choice) {
+            case 1:
+                routingIndexBenchmark();
+                break;
+            case 2:
+                batchSolveDemo();
+                break;
+            case 3:
+                bitParallelBenchmark();
+                break;
+            case 4:
+                reachabilityBenchmark();
+                break;
+            default:
+                std::cout << "无效选择！" << std::endl;
+                break;
+        }
+    }
+
+    void routingIndexBenchmark() {
+        std::cout << "请输入随机查询次数: ";
+        int queryCount;
+        std::cin >> queryCount;
+        if (queryCount <= 0) {
+            std::cout << "查询次数必须为正数！" << std::endl;
+            return;
+        }
+
+        std::cout << "正在构建路由索引..." << std::endl;
+        RoutingIndex index(*maze);
+        std::cout << "节点数: " << index.getNodeCount()
+                  << "  走廊数: " << index.getCorridorCount()
+                  << "  捷径数: " << index.getShortcutCount() << std::endl;
+        std::cout << "构建时间: " << index.getBuildTime() << " ms  内存: "
+                  << index.memoryBytes() / 1024 << " KB" << std::endl;
+
+        // 固定种子，便于多次运行比较
+        std::mt19937 rng(12345);
+        std::vector<std::pair<Point, Point>> queries;
+        queries.reserve(queryCount);
+        for (int i = 0; i < queryCount; i++) {
+            int a = static_cast<int>(rng() % maze->getCellCount());
+            int b = static_cast<int>(rng() % maze->getCellCount());
+            queries.emplace_back(maze->fromIndex(a), maze->fromIndex(b));
+        }
+
+        std::vector<int> indexAnswers(queryCount);
+        int mismatches = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < queryCount; i++) {
+            indexAnswers[i] = index.distance(queries[i].first, queries[i].second);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double indexTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        // 完美迷宫额外比较树索引
+        double treeTime = -1;
+        if (PathFinder::treeDistance(*maze, queries[0].first, queries[0].second) >= 0) {
+            start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < queryCount; i++) {
+                if (PathFinder::treeDistance(*maze, queries[i].first, queries[i].second) != indexAnswers[i]) {
+                    mismatches++;
+                }
+            }
+            end = std::chrono::high_resolution_clock::now();
+            treeTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        }
+
+        // 逐次BFS需要临时改写入口和出口，结束后恢复
+        Point entrance = maze->getEntrance();
+        Point exit = maze->getExit();
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < queryCount; i++) {
+            maze->setEntrance(queries[i].first);
+            maze->setExit(queries[i].second);
+            auto result = pathFinder.findPathBFS(*maze);
+            int expected = result.found ? result.steps : -1;
+            if (expected != indexAnswers[i]) mismatches++;
+        }
+        end = std::chrono::high_resolution_clock::now();
+        double bfsTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        restoreEntranceAndExit(entrance, exit);
+
+        std::cout << "路由索引: " << indexTime / queryCount << " us/次" << std::endl;
+        if (treeTime >= 0) {
+            std::cout << "树索引:   " << treeTime / queryCount << " us/次" << std::endl;
+        }
+        std::cout << "逐次BFS:  " << bfsTime / queryCount << " us/次" << std::endl;
+        if (indexTime > 0) {
+            std::cout << "加速比: " << bfsTime / indexTime << "x" << std::endl;
+        }
+        std::cout << "结果不一致的查询数: " << mismatches << std::endl;
+    }
+
+    void batchSolveDemo() {
+        int sourceCount, targetCount;
+        std::cout << "请输入入口数量和出口数量: ";
+        std::cin >> sourceCount >> targetCount;
+        if (sourceCount <= 0 || targetCount <= 0) {
+            std::cout << "数量必须为正数！" << std::endl;
+            return;
+        }
+
+        // 固定种子随机选取入口和出口
+        std::mt19937 rng(2024);
+        std::vector<Point> sources, targets;
+        for (int i = 0; i < sourceCount; i++) {
+            sources.push_back(maze->fromIndex(static_cast<int>(rng() % maze->getCellCount())));
+        }
+        for (int j = 0; j < targetCount; j++) {
+            targets.push_back(maze->fromIndex(static_cast<int>(rng() % maze->getCellCount())));
+        }
+
+        PathFinder::BatchResult batch = pathFinder.findDistances(*maze, sources, targets);
+        std::cout << "批量求解: " << batch.searchTime << " ms, 访问格子 " << batch.visitedNodes << std::endl;
+
+        int shown = std::min(sourceCount, 10);
+        for (int i = 0; i < shown; i++) {
+            int nearest = batch.nearestTarget(i);
+            std::cout << "入口(" << sources[i].x << "," << sources[i].y << ") ";
+            if (nearest < 0) {
+                std::cout << "无法到达任何出口" << std::endl;
+            } else {
+                std::cout << "最近的出口(" << targets[nearest].x << "," << targets[nearest].y
+                          << ") 距离 " << batch.distance(i, nearest) << std::endl;
+            }
+        }
+        if (shown < sourceCount) {
+            std::cout << "... 共 " << sourceCount << " 个入口" << std::endl;
+        }
+
+        // 对比：逐对修改入口出口后调用BFS
+        Point entrance = maze->getEntrance();
+        Point exit = maze->getExit();
+        int mismatches = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < sourceCount; i++) {
+            for (int j = 0; j < targetCount; j++) {
+                maze->setEntrance(sources[i]);
+                maze->setExit(targets[j]);
+                auto result = pathFinder.findPathBFS(*maze);
+                if ((result.found ? result.steps : -1) != batch.distance(i, j)) mismatches++;
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        restoreEntranceAndExit(entrance, exit);
+
+        double pairTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+        std::cout << "逐对BFS: " << pairTime << " ms" << std::endl;
+        if (batch.searchTime > 0) {
+            std::cout << "加速比: " << pairTime / batch.searchTime << "x" << std::endl;
+        }
+        std::cout << "结果不一致的数量: " << mismatches << std::endl;
+    }
+
+    void bitParallelBenchmark() {
+        const int sourceCount = 64;
+        std::mt19937 rng(64);
+        std::vector<Point> sources;
+        for (int i = 0; i < sourceCount; i++) {
+            sources.push_back(maze->fromIndex(static_cast<int>(rng() % maze->getCellCount())));
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::vector<int>> distances = pathFinder.multiSourceDistances(*maze, sources);
+        auto end = std::chrono::high_resolution_clock::now();
+        double bitTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+
+        // 离心率：起点到它能到达的最远格子的距离；最大值是迷宫直径的下界
+        int minEccentricity = -1, maxEccentricity = 0;
+        double totalEccentricity = 0;
+        for (const std::vector<int>& row : distances) {
+            int eccentricity = *std::max_element(row.begin(), row.end());
+            if (minEccentricity < 0 || eccentricity < minEccentricity) minEccentricity = eccentricity;
+            maxEccentricity = std::max(maxEccentricity, eccentricity);
+            totalEccentricity += eccentricity;
+        }
+        std::cout << "离心率: 最小 " << minEccentricity << "  平均 " << totalEccentricity / sourceCount
+                  << "  最大 " << maxEccentricity << "（直径至少为 " << maxEccentricity << "）" << std::endl;
+
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<std::vector<int>> scalar = pathFinder.multiSourceDistances(*maze, sources, false);
+        end = std::chrono::high_resolution_clock::now();
+        double scalarTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+
+        // 64次findPathBFS：每次只求到出口的路径，遇到出口就停止
+        Point entrance = maze->getEntrance();
+        Point exit = maze->getExit();
+        start = std::chrono::high_resolution_clock::now();
+        for (const Point& source : sources) {
+            maze->setEntrance(source);
+            pathFinder.findPathBFS(*maze);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        restoreEntranceAndExit(entrance, exit);
+        double bfsTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+
+        std::cout << "位并行BFS（全图距离）:    " << bitTime << " ms" << std::endl;
+        std::cout << "逐个BFS（全图距离）:      " << scalarTime << " ms" << std::endl;
+        std::cout << "64次findPathBFS（到出口）: " << bfsTime << " ms" << std::endl;
+        std::cout << "结果一致: " << (scalar == distances ? "是" : "否") << std::endl;
+    }
+
+    void reachabilityBenchmark() {
+        for (bool useBitRows : {true, false}) {
+            ReachabilityEngine engine(*maze, useBitRows);
+            auto start = std::chrono::high_resolution_clock::now();
+            std::size_t reached = engine.floodFill(maze->getEntrance());
+            bool exitReachable = engine.isFilled(maze->getExit());
+            auto middle = std::chrono::high_resolution_clock::now();
+            std::vector<std::size_t> components = engine.componentSizes();
+            auto end = std::chrono::high_resolution_clock::now();
+
+            std::size_t largest = components.empty() ? 0 : *std::max_element(components.begin(), components.end());
+            std::cout << (engine.usesBitRows() ? "位行泛洪: " : "逐格泛洪: ")
+                      << "入口可达 " << reached << " 格，出口" << (exitReachable ? "可达" : "不可达")
+                      << "（" << std::chrono::duration_cast<std::chrono::microseconds>(middle - start).count() / 1000.0
+                      << " ms）；连通分量 " << components.size() << " 个，最大 " << largest << " 格（"
+                      << std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count() / 1000.0
+                      << " ms）" << std::endl;
+            if (!engine.usesBitRows() && useBitRows) {
+                std::cout << "非矩形迷宫只能使用逐格泛洪。" << std::endl;
+                break;
+            }
+        }
+    }
+
+    void restoreEntranceAndExit(const Point& entrance, const Point& exit) {
+        // 临时端点可能与原入口重合，恢复出口时会把它改回普通格子，所以最后再设一次入口
+        maze->setEntrance(entrance);
+        maze->setExit(exit);
+        maze->setEntrance(entrance);
+    }
+
     void mondrianMazeAdventure(const Visualizer& visualizer) {
         MondrianMaze mondrian;
+        std::cout << "蒙德里安迷宫随机种子: " << mondrian.getSeed() << std::endl;
         
         // 1. 快速找到最短路径长度
         std::vector<int> shortestPath = mondrian.findPath(mondrian.getEntranceId(), mondrian.getExitId(), 1);
@@ -475,8 +897,104 @@ private:
     }
 };
 
-int main() {
+void printUsage(const char* program) {
+    std::cout << "用法:\n"
+              << "  " << program << "                      交互式菜单\n"
+              << "  " << program << " --batch key=value ...  执行一个作业\n"
+              << "  " << program << " --jobs FILE            逐行执行作业文件（-表示标准输入）\n"
+              << "  " << program << " --serve [--socket PATH] [--threads N]\n"
+              << "                                   常驻服务：从标准输入或Unix套接字读取每行一个JSON作业\n"
+              << "作业参数: type=rect|circular|mondrian rows=N cols=N size=RxC rings=N\n"
+              << "          generator=dfs|kruskal|eller|parallel|random wall_removal=P seed=N repeat=N\n"
+              << "          solvers=bfs,dfs,astar,bibfs,biastar,jps,tree,pbfs|all\n"
+              << "          export=text|html|maze|none output=PATH（可用{n}和{seed}占位）\n";
+}
+
+// 批处理模式：结果行写到标准输出，生成和导出过程中的提示信息被丢弃，返回失败的作业数
+int runBatch(const std::vector<std::string>& args) {
+    std::ios::sync_with_stdio(false);
+    std::ostream results(std::cout.rdbuf());
+    std::ofstream discard("/dev/null");
+    std::cout.rdbuf(discard.rdbuf());
+
+    BatchRunner runner;
+    int failed = 0;
+    if (args[0] == "--jobs") {
+        if (args.size() != 2) {
+            std::cerr << "--jobs 需要一个作业文件" << std::endl;
+            failed = 1;
+        } else if (args[1] == "-") {
+            failed = runner.runJobFile(std::cin, results);
+        } else {
+            std::ifstream jobs(args[1]);
+            if (!jobs.is_open()) {
+                std::cerr << "无法打开作业文件: " << args[1] << std::endl;
+                failed = 1;
+            } else {
+                failed = runner.runJobFile(jobs, results);
+            }
+        }
+    } else {
+        JobSpec spec;
+        std::string error;
+        if (!spec.parseArguments(std::vector<std::string>(args.begin() + 1, args.end()), error)) {
+            std::cerr << error << std::endl;
+            failed = 1;
+        } else {
+            failed = runner.run(spec, results) ? 0 : 1;
+        }
+    }
+    results.flush();
+    std::cout.rdbuf(results.rdbuf());
+    return failed;
+}
+
+// 服务器模式：没有--socket时从标准输入读作业、向标准输出写结果
+int runServer(const std::vector<std::string>& args) {
+    std::string socketPath;
+    int threads = 0;
+    for (std::size_t i = 1; i < args.size(); i++) {
+        if (i + 1 >= args.size()) {
+            std::cerr << "参数缺少取值: " << args[i] << std::endl;
+            return 1;
+        }
+        if (args[i] == "--socket") socketPath = args[++i];
+        else if (args[i] == "--threads") threads = std::max(1, std::atoi(args[++i].c_str()));
+        else {
+            std::cerr << "未知参数: " << args[i] << std::endl;
+            return 1;
+        }
+    }
+
+    std::ios::sync_with_stdio(false);
+    std::ostream results(std::cout.rdbuf());
+    std::ofstream discard("/dev/null");
+    std::cout.rdbuf(discard.rdbuf());
+
+    JobServer server(threads);
+    int status = 0;
+    if (!socketPath.empty()) {
+        status = server.serveSocket(socketPath) ? 0 : 1;
+    } else {
+        status = server.serveStream(std::cin, results) == 0 ? 0 : 1;
+    }
+    std::cout.rdbuf(results.rdbuf());
+    return status;
+}
+
+int main(int argc, char* argv[]) {
     try {
+        std::vector<std::string> args(argv + 1, argv + argc);
+        if (!args.empty()) {
+            if (args[0] == "--batch" || args[0] == "--jobs") {
+                return runBatch(args) == 0 ? 0 : 1;
+            }
+            if (args[0] == "--serve") {
+                return runServer(args);
+            }
+            printUsage(argv[0]);
+            return (args[0] == "--help" || args[0] == "-h") ? 0 : 1;
+        }
         MazeApplication app;
         app.run();
     } catch (const std::exception& e) {
@@ -1,23 +1,24 @@
 #include "maze.h"
+#include "jump_point_table.h"
+#include "tree_index.h"
+#include "reachability.h"
+#include "disjoint_set.h"
+#include "eller_generator.h"
+#include "maze_renderer.h"
 #include <algorithm>
 #include <stack>
 #include <iostream>
 #include <iomanip>
+#include <cstdlib>
+#include <climits>
 
 /**
  * 迷宫类实现 - 使用线段表示墙壁
  */
 
-Maze::Maze(int rows, int cols) : rows(rows), cols(cols), rng(std::random_device{}()) {
-    // 初始化迷宫网格
-    grid.resize(rows, std::vector<MazeCell>(cols));
-    
-    // 初始化所有格子都有四面墙
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            grid[i][j] = MazeCell();  // 默认构造函数会设置所有墙壁
-        }
-    }
+Maze::Maze(int rows, int cols) : rows(rows), cols(cols), storage(rows, cols),
+      seed(Xoshiro256::randomSeed()), rng(seed) {
+    // 存储初始化时所有墙都存在
     
     // 设置默认入口和出口
     entrance = Point(0, 0);
@@ -26,37 +27,69 @@ Maze::Maze(int rows, int cols) : rows(rows), cols(cols), rng(std::random_device{
     setCellType(exit, CellType::EXIT);
 }
 
-const MazeCell& Maze::getCell(int x, int y) const {
-    if (!isValidPosition(Point(x, y))) {
+Maze::Maze(MazeStorage&& storage, const Point& entrance, const Point& exit)
+    : rows(storage.getRows()), cols(storage.getCols()), storage(std::move(storage)),
+      entrance(entrance), exit(exit),
+      seed(Xoshiro256::randomSeed()), rng(seed) {}
+
+MazeCell Maze::getCell(int x, int y) const {
+    if (!isValidPosition(Point(x, y)) || !inGrid(x, y)) {
         throw std::out_of_range("Get cell: coordinates out of range.");
     }
-    return grid[x][y];
+    MazeCell cell;
+    for (int d = 0; d < 4; d++) {
+        cell.walls[d] = hasWall(x, y, static_cast<WallDirection>(d));
+    }
+    cell.type = static_cast<CellType>(storage.cellType(x, y));
+    return cell;
+}
+
+CellType Maze::getCellType(int x, int y) const {
+    if (!inGrid(x, y)) return CellType::PATH;
+    return static_cast<CellType>(storage.cellType(x, y));
 }
 
 void Maze::setCellType(int x, int y, CellType type) {
-    if (isValidPosition(Point(x, y))) {
-        grid[x][y].type = type;
+    if (isValidPosition(Point(x, y)) && inGrid(x, y)) {
+        storage.setCellType(x, y, static_cast<std::uint8_t>(type));
     }
 }
 
 bool Maze::hasWall(int x, int y, WallDirection dir) const {
-    if (!isValidPosition(Point(x, y))) {
+    if (!isValidPosition(Point(x, y)) || !inGrid(x, y)) {
         return true;  // 边界外视为有墙
     }
-    return grid[x][y].hasWall(dir);
+    // 相邻格子共享同一位：上墙即上方格子的下墙，左墙即左侧格子的右墙
+    switch (dir) {
+        case WallDirection::TOP:    return x == 0 ? storage.topBorder(y) : storage.bottomWall(x - 1, y);
+        case WallDirection::RIGHT:  return storage.rightWall(x, y);
+        case WallDirection::BOTTOM: return storage.bottomWall(x, y);
+        case WallDirection::LEFT:   return y == 0 ? storage.leftBorder(x) : storage.rightWall(x, y - 1);
+        default: return true;
+    }
 }
 
 void Maze::setWall(int x, int y, WallDirection dir, bool hasWall) {
-    if (!isValidPosition(Point(x, y))) return;
-    
-    grid[x][y].setWall(dir, hasWall);
+    if (!isValidPosition(Point(x, y)) || !inGrid(x, y)) return;
     
-    // 同时更新相邻格子的对应墙壁
-    Point adjacent = getAdjacentCell(Point(x, y), dir);
-    if (isValidPosition(adjacent)) {
-        WallDirection oppositeDir = getOppositeDirection(dir);
-        grid[adjacent.x][adjacent.y].setWall(oppositeDir, hasWall);
+    // 共享墙壁只存一位，相邻格子的对应墙壁自动同步
+    switch (dir) {
+        case WallDirection::TOP:
+            if (x == 0) storage.setTopBorder(y, hasWall);
+            else storage.setBottomWall(x - 1, y, hasWall);
+            break;
+        case WallDirection::RIGHT:
+            storage.setRightWall(x, y, hasWall);
+            break;
+        case WallDirection::BOTTOM:
+            storage.setBottomWall(x, y, hasWall);
+            break;
+        case WallDirection::LEFT:
+            if (y == 0) storage.setLeftBorder(x, hasWall);
+            else storage.setRightWall(x, y - 1, hasWall);
+            break;
     }
+    wallsChanged();
 }
 
 void Maze::removeWall(int x, int y, WallDirection dir) {
@@ -93,23 +126,19 @@ void Maze::removeWallBetween(const Point& p1, const Point& p2) {
     // 只处理相邻格子
     if (abs(dx) + abs(dy) != 1) return;
     
-    WallDirection dir1, dir2;
+    WallDirection dir;
     if (dx == -1) {  // p2在p1上方
-        dir1 = WallDirection::TOP;
-        dir2 = WallDirection::BOTTOM;
+        dir = WallDirection::TOP;
     } else if (dx == 1) {  // p2在p1下方
-        dir1 = WallDirection::BOTTOM;
-        dir2 = WallDirection::TOP;
+        dir = WallDirection::BOTTOM;
     } else if (dy == -1) {  // p2在p1左边
-        dir1 = WallDirection::LEFT;
-        dir2 = WallDirection::RIGHT;
+        dir = WallDirection::LEFT;
     } else {  // p2在p1右边
-        dir1 = WallDirection::RIGHT;
-        dir2 = WallDirection::LEFT;
+        dir = WallDirection::RIGHT;
     }
     
-    grid[p1.x][p1.y].removeWall(dir1);
-    grid[p2.x][p2.y].removeWall(dir2);
+    // 两个格子共享同一个墙壁位，移除一次即可
+    removeWall(p1, dir);
 }
 
 void Maze::setEntrance(const Point& p) {
@@ -133,23 +162,20 @@ void Maze::setExit(const Point& p) {
 }
 
 void Maze::generateRandomMaze(double wallRemovalProbability) {
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    
     // 重新初始化所有格子为有四面墙
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            grid[i][j] = MazeCell();
-        }
-    }
+    storage.reset();
+    wallsChanged();
+    setCellType(entrance, CellType::ENTRANCE);
+    setCellType(exit, CellType::EXIT);
     
     // 随机移除一些内部墙壁
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
             // 尝试移除右墙和下墙（避免重复处理相邻墙壁）
-            if (j < cols - 1 && dist(rng) < wallRemovalProbability) {
+            if (j < cols - 1 && rng.uniform() < wallRemovalProbability) {
                 removeWall(i, j, WallDirection::RIGHT);
             }
-            if (i < rows - 1 && dist(rng) < wallRemovalProbability) {
+            if (i < rows - 1 && rng.uniform() < wallRemovalProbability) {
                 removeWall(i, j, WallDirection::BOTTOM);
             }
         }
@@ -181,16 +207,11 @@ void Maze::generateRandomMaze(double wallRemovalProbability) {
 
 void Maze::generateWithDFS() {
     // 重新初始化所有格子为有四面墙
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            grid[i][j] = MazeCell();
-            grid[i][j].type = CellType::PATH;
-        }
-    }
+    storage.reset();
+    wallsChanged();
     
     std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
     std::stack<Point> stack;
-    std::uniform_int_distribution<int> dist(0, 3);
     
     // 从入口开始
     Point current = entrance;
@@ -216,7 +237,7 @@ void Maze::generateWithDFS() {
         
         if (!unvisitedNeighbors.empty()) {
             // 随机选择一个未访问的邻居
-            int randIndex = dist(rng) % unvisitedNeighbors.size();
+            int randIndex = rng.below(static_cast<std::uint32_t>(unvisitedNeighbors.size()));
             Point next = unvisitedNeighbors[randIndex];
             
             // 移除当前格子和选中邻居之间的墙
@@ -235,9 +256,76 @@ void Maze::generateWithDFS() {
     setCellType(exit, CellType::EXIT);
 }
 
+void Maze::generateWithKruskal() {
+    // 直接改写位平面依赖矩形网格布局，其它形状交给各自的生成算法
+    if (!isRectangularGrid()) {
+        generate();
+        return;
+    }
+
+    storage.reset();
+    wallsChanged();
+
+    // 内墙编号：格子编号 * 2 + (0右墙 / 1下墙)；格子数可达INT_MAX，编号用32位无符号数才不会溢出
+    std::int64_t cellCount = static_cast<std::int64_t>(rows) * cols;
+    std::vector<std::uint32_t> edges;
+    edges.reserve(static_cast<std::size_t>(cellCount) * 2);
+    for (int x = 0; x < rows; x++) {
+        for (int y = 0; y < cols; y++) {
+            std::uint32_t cell = static_cast<std::uint32_t>(x) * cols + y;
+            if (y + 1 < cols) edges.push_back(cell * 2);
+            if (x + 1 < rows) edges.push_back(cell * 2 + 1);
+        }
+    }
+    rng.shuffle(edges.begin(), edges.end());
+
+    DisjointSet sets;
+    sets.reset(static_cast<int>(cellCount));
+    std::int64_t remaining = cellCount - 1;
+    for (std::uint32_t edge : edges) {
+        if (remaining == 0) break;
+        int cell = static_cast<int>(edge >> 1);
+        bool bottom = edge & 1;
+        if (!sets.unite(cell, bottom ? cell + cols : cell + 1)) continue;
+        if (bottom) {
+            storage.setBottomWall(cell / cols, cell % cols, false);
+        } else {
+            storage.setRightWall(cell / cols, cell % cols, false);
+        }
+        remaining--;
+    }
+
+    // 设置入口出口类型
+    setCellType(entrance, CellType::ENTRANCE);
+    setCellType(exit, CellType::EXIT);
+}
+
+void Maze::generateWithEller() {
+    if (!isRectangularGrid()) {
+        generate();
+        return;
+    }
+
+    // 生成器输出的行与存储的行布局相同，直接写入位平面
+    storage.reset();
+    wallsChanged();
+    EllerGenerator generator(cols, rng());
+    for (int x = 0; x < rows; x++) {
+        generator.nextRow(storage.rightRow(x), storage.bottomRow(x), x == rows - 1);
+    }
+
+    // 设置入口出口类型
+    setCellType(entrance, CellType::ENTRANCE);
+    setCellType(exit, CellType::EXIT);
+}
+
 void Maze::generate() {
-    // 默认生成方式调用DFS生成
-    this->generateWithDFS();
+    // 按选择的算法生成完美迷宫（默认DFS）
+    switch (generationAlgorithm) {
+        case GenerationAlgorithm::KRUSKAL: generateWithKruskal(); break;
+        case GenerationAlgorithm::ELLER:   generateWithEller(); break;
+        default:                           generateWithDFS(); break;
+    }
 }
 
 void Maze::generatePerfectMaze() {
@@ -276,20 +364,67 @@ bool Maze::canMoveTo(const Point& from, const Point& to) const {
 }
 
 std::vector<Point> Maze::getAccessibleNeighbors(const Point& p) const {
-    std::vector<Point> neighbors;
-    std::vector<WallDirection> directions = {
-        WallDirection::TOP, WallDirection::RIGHT, 
-        WallDirection::BOTTOM, WallDirection::LEFT
-    };
+    NeighborList list;
+    getAccessibleNeighbors(p, list);
+    return std::vector<Point>(list.begin(), list.end());
+}
+
+void Maze::getAccessibleNeighbors(const Point& p, NeighborList& out) const {
+    out.clear();
+    if (!isValidPosition(p)) return;
     
-    for (WallDirection dir : directions) {
-        Point neighbor = getAdjacentCell(p, dir);
-        if (isValidPosition(neighbor) && !hasWall(p, dir)) {
-            neighbors.push_back(neighbor);
-        }
+    // 按上、右、下、左的顺序输出，与原有的邻居顺序一致
+    unsigned open = getOpenDirections(p.x, p.y);
+    if (open & (1u << static_cast<int>(WallDirection::TOP)))    out.push(Point(p.x - 1, p.y));
+    if (open & (1u << static_cast<int>(WallDirection::RIGHT)))  out.push(Point(p.x, p.y + 1));
+    if (open & (1u << static_cast<int>(WallDirection::BOTTOM))) out.push(Point(p.x + 1, p.y));
+    if (open & (1u << static_cast<int>(WallDirection::LEFT)))   out.push(Point(p.x, p.y - 1));
+}
+
+
+int Maze::getCellCount() const {
+    return rows * cols;
+}
+
+bool Maze::isSupportedSize(long long rows, long long cols) {
+    return rows > 0 && cols > 0 && rows <= INT_MAX / cols;
+}
+
+int Maze::toIndex(const Point& p) const {
+    return p.x * cols + p.y;
+}
+
+Point Maze::fromIndex(int index) const {
+    return Point(index / cols, index % cols);
+}
+
+std::shared_ptr<const JumpPointTable> Maze::getJumpPointTable() const {
+    // 多个求解线程可能同时读取同一个迷宫，用原子操作发布构建好的表
+    std::shared_ptr<const JumpPointTable> table = std::atomic_load(&jumpTable);
+    if (!table) {
+        table = std::make_shared<const JumpPointTable>(*this);
+        std::atomic_store(&jumpTable, table);
     }
-    
-    return neighbors;
+    return table;
+}
+
+std::shared_ptr<const TreeIndex> Maze::getTreeIndex() const {
+    std::shared_ptr<const TreeIndex> index = std::atomic_load(&treeIndex);
+    if (!index) {
+        index = std::make_shared<const TreeIndex>(*this);
+        std::atomic_store(&treeIndex, index);
+    }
+    return index;
+}
+
+int Maze::getDistanceLowerBound(int from, int to) const {
+    // 曼哈顿距离
+    int fromX = from / cols, toX = to / cols;
+    return std::abs(fromX - toX) + std::abs((from - fromX * cols) - (to - toX * cols));
+}
+
+int Maze::getNeighborIndices(int index, int* out) const {
+    return getGridNeighborIndices(index, out);
 }
 
 std::vector<Point> Maze::getAllNeighbors(const Point& p) const {
@@ -312,8 +447,8 @@ std::vector<Point> Maze::getAllNeighbors(const Point& p) const {
 void Maze::resetVisited() {
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
-            if (grid[i][j].type == CellType::VISITED) {
-                grid[i][j].type = CellType::PATH;
+            if (storage.cellType(i, j) == static_cast<std::uint8_t>(CellType::VISITED)) {
+                storage.setCellType(i, j, static_cast<std::uint8_t>(CellType::PATH));
             }
         }
     }
@@ -322,6 +457,13 @@ void Maze::resetVisited() {
 }
 
 void Maze::printMaze() const {
+    if (isRectangularGrid()) {
+        MazeRenderer renderer(MazeRenderer::Style::PLAIN);
+        renderer.render(*this);
+        renderer.present(std::cout);
+        return;
+    }
+
     std::cout << "\n迷宫结构（使用线段表示墙壁）：\n";
     
     // 打印顶部边界
@@ -337,7 +479,7 @@ void Maze::printMaze() const {
         std::cout << (hasWall(i, 0, WallDirection::LEFT) ? "│" : " ");
         for (int j = 0; j < cols; j++) {
             // 打印格子内容
-            switch (grid[i][j].type) {
+            switch (getCellType(i, j)) {
                 case CellType::ENTRANCE: std::cout << " S "; break;
                 case CellType::EXIT:     std::cout << " E "; break;
                 case CellType::VISITED:  std::cout << " · "; break;
@@ -394,6 +536,13 @@ void Maze::printMaze() const {
 }
 
 void Maze::printMazeWithPath(const std::vector<Point>& path) const {
+    if (isRectangularGrid()) {
+        MazeRenderer renderer(MazeRenderer::Style::PLAIN);
+        renderer.render(*this, path);
+        renderer.present(std::cout);
+        return;
+    }
+
     // 创建临时副本
     Maze temp = clone();
     
@@ -421,24 +570,16 @@ void Maze::printMazeDetailed() const {
 
 Maze Maze::clone() const {
     Maze copy(rows, cols);
-    copy.grid = grid;
+    copy.storage = storage;
     copy.entrance = entrance;
     copy.exit = exit;
     return copy;
 }
 
 int Maze::countWalls() const {
-    int count = 0;
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            for (int d = 0; d < 4; d++) {
-                if (grid[i][j].hasWall(static_cast<WallDirection>(d))) {
-                    count++;
-                }
-            }
-        }
-    }
-    return count / 2;  // 每面墙被计算了两次
+    // 按格子逐面统计时内部墙被计算两次、边界墙计算一次，结果再除以2
+    std::size_t count = 2 * storage.countInteriorWalls() + storage.countBorderWalls();
+    return static_cast<int>(count / 2);
 }
 
 int Maze::countOpenPaths() const {
@@ -446,6 +587,11 @@ int Maze::countOpenPaths() const {
     return totalPossibleWalls - countWalls();
 }
 
+bool Maze::isExitReachable() const {
+    ReachabilityEngine engine(*this);
+    return engine.isReachable(entrance, exit);
+}
+
 double Maze::getConnectivity() const {
     int totalPossibleWalls = 2 * rows * cols - rows - cols;
     int openPaths = countOpenPaths();
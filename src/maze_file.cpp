@@ -0,0 +1,241 @@
+#include "maze_file.h"
+#include "eller_generator.h"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <climits>
+#include <vector>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * 二进制迷宫文件的实现
+ * 两个平面与内存中的MazeStorage逐字节相同，读写都是整块的write/read，映射时直接把指针交给存储
+ */
+
+namespace {
+
+const char MAGIC[8] = {'M', 'A', 'Z', 'E', 'B', 'I', 'N', '\0'};
+
+static_assert(sizeof(MazeFile::Header) == MazeFile::HEADER_SIZE, "迷宫文件头部必须是64字节");
+
+std::uint64_t payloadSize(int rows, int cols) {
+    return MazeStorage::wordCountFor(rows, cols) * sizeof(std::uint64_t) + MazeStorage::typeBytesFor(rows, cols);
+}
+
+// 映射区域的所有者：最后一个引用释放时解除映射
+class Mapping {
+public:
+    Mapping(void* address, std::size_t length) : address(address), length(length) {}
+    ~Mapping() { munmap(address, length); }
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+private:
+    void* address;
+    std::size_t length;
+};
+
+} // namespace
+
+MazeFile::Header MazeFile::makeHeader(int rows, int cols, const Point& entrance, const Point& exit,
+                                      std::uint64_t seed, GenerationAlgorithm generator) {
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = HEADER_SIZE;
+    header.rows = rows;
+    header.cols = cols;
+    header.entranceX = entrance.x;
+    header.entranceY = entrance.y;
+    header.exitX = exit.x;
+    header.exitY = exit.y;
+    header.seed = seed;
+    header.generator = static_cast<std::uint32_t>(generator);
+    header.wallWords = MazeStorage::wordCountFor(rows, cols);
+    return header;
+}
+
+bool MazeFile::validate(const Header& header, std::uint64_t fileSize, const std::string& filename) {
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "不是迷宫文件: " << filename << std::endl;
+        return false;
+    }
+    if (header.version != VERSION || header.headerSize != HEADER_SIZE) {
+        std::cerr << "不支持的迷宫文件版本: " << filename << std::endl;
+        return false;
+    }
+    if (header.rows <= 0 || header.cols <= 0 ||
+        header.wallWords != MazeStorage::wordCountFor(header.rows, header.cols) ||
+        header.entranceX < 0 || header.entranceX >= header.rows || header.entranceY < 0 || header.entranceY >= header.cols ||
+        header.exitX < 0 || header.exitX >= header.rows || header.exitY < 0 || header.exitY >= header.cols) {
+        std::cerr << "迷宫文件头部已损坏: " << filename << std::endl;
+        return false;
+    }
+    if (!Maze::isSupportedSize(header.rows, header.cols)) {
+        std::cerr << "迷宫尺寸过大（格子数超过" << INT_MAX << "）: " << filename << std::endl;
+        return false;
+    }
+    if (fileSize < HEADER_SIZE + payloadSize(header.rows, header.cols)) {
+        std::cerr << "迷宫文件不完整: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MazeFile::save(const Maze& maze, const std::string& filename, bool quiet) {
+    if (!maze.isRectangularGrid()) {
+        if (!quiet) std::cerr << "二进制迷宫文件只支持矩形迷宫" << std::endl;
+        return false;
+    }
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        if (!quiet) std::cerr << "无法创建迷宫文件: " << filename << std::endl;
+        return false;
+    }
+
+    const MazeStorage& storage = maze.getStorage();
+    Header header = makeHeader(maze.getRows(), maze.getCols(), maze.getEntrance(), maze.getExit(),
+                               maze.getSeed(), maze.getGenerationAlgorithm());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(storage.wordData()), storage.wordCount() * sizeof(std::uint64_t));
+    file.write(reinterpret_cast<const char*>(storage.typeData()), storage.typeBytes());
+    if (!file) {
+        if (!quiet) std::cerr << "写入迷宫文件失败: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MazeFile::readHeader(const std::string& filename, Header& header) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "无法打开迷宫文件: " << filename << std::endl;
+        return false;
+    }
+    std::uint64_t fileSize = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(0);
+    if (fileSize < HEADER_SIZE || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        std::cerr << "不是迷宫文件: " << filename << std::endl;
+        return false;
+    }
+    return validate(header, fileSize, filename);
+}
+
+std::unique_ptr<Maze> MazeFile::load(const std::string& filename) {
+    Header header;
+    if (!readHeader(filename, header)) return nullptr;
+
+    std::ifstream file(filename, std::ios::binary);
+    file.seekg(HEADER_SIZE);
+    MazeStorage storage(header.rows, header.cols);
+    file.read(reinterpret_cast<char*>(storage.wordData()), storage.wordCount() * sizeof(std::uint64_t));
+    file.read(reinterpret_cast<char*>(storage.typeData()), storage.typeBytes());
+    if (!file) {
+        std::cerr << "读取迷宫文件失败: " << filename << std::endl;
+        return nullptr;
+    }
+
+    std::unique_ptr<Maze> maze(new Maze(std::move(storage), Point(header.entranceX, header.entranceY),
+                                        Point(header.exitX, header.exitY)));
+    maze->setGenerationAlgorithm(static_cast<GenerationAlgorithm>(header.generator));
+    maze->setSeed(header.seed);
+    return maze;
+}
+
+std::unique_ptr<Maze> MazeFile::map(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "无法打开迷宫文件: " << filename << std::endl;
+        return nullptr;
+    }
+    struct stat info;
+    Header header;
+    if (fstat(fd, &info) != 0 || static_cast<std::uint64_t>(info.st_size) < HEADER_SIZE ||
+        pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        !validate(header, static_cast<std::uint64_t>(info.st_size), filename)) {
+        close(fd);
+        return nullptr;
+    }
+
+    // 私有映射：修改格子类型（标记路径、改入口出口）只影响本进程的页面副本
+    std::size_t length = static_cast<std::size_t>(info.st_size);
+    void* address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        std::cerr << "映射迷宫文件失败: " << filename << std::endl;
+        return nullptr;
+    }
+
+    auto mapping = std::make_shared<Mapping>(address, length);
+    char* base = static_cast<char*>(address);
+    std::uint64_t* words = reinterpret_cast<std::uint64_t*>(base + HEADER_SIZE);
+    std::uint8_t* types = reinterpret_cast<std::uint8_t*>(base + HEADER_SIZE + header.wallWords * sizeof(std::uint64_t));
+    MazeStorage storage = MazeStorage::adopt(header.rows, header.cols, words, types, mapping);
+
+    std::unique_ptr<Maze> maze(new Maze(std::move(storage), Point(header.entranceX, header.entranceY),
+                                        Point(header.exitX, header.exitY)));
+    maze->setGenerationAlgorithm(static_cast<GenerationAlgorithm>(header.generator));
+    maze->setSeed(header.seed);
+    return maze;
+}
+
+bool MazeFile::writeEller(const std::string& filename, int rows, int cols, std::uint64_t seed) {
+    if (rows <= 0 || cols <= 0) {
+        std::cerr << "迷宫尺寸无效" << std::endl;
+        return false;
+    }
+    if (!Maze::isSupportedSize(rows, cols)) {
+        std::cerr << "迷宫尺寸过大（格子数超过" << INT_MAX << "）" << std::endl;
+        return false;
+    }
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "无法创建迷宫文件: " << filename << std::endl;
+        return false;
+    }
+
+    Header header = makeHeader(rows, cols, Point(0, 0), Point(rows - 1, cols - 1), seed, GenerationAlgorithm::ELLER);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // 墙壁位平面：逐行写出右墙字和下墙字，再写上边界和左边界（全部是墙）
+    EllerGenerator generator(cols, seed);
+    std::size_t wordsPerRow = generator.getWordsPerRow();
+    std::vector<std::uint64_t> row(2 * wordsPerRow);
+    for (int x = 0; x < rows && file; x++) {
+        generator.nextRow(row.data(), row.data() + wordsPerRow, x == rows - 1);
+        file.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(std::uint64_t));
+    }
+    std::size_t borderWords = header.wallWords - static_cast<std::size_t>(rows) * 2 * wordsPerRow;
+    std::vector<std::uint64_t> border(borderWords, ~std::uint64_t(0));
+    file.write(reinterpret_cast<const char*>(border.data()), border.size() * sizeof(std::uint64_t));
+
+    // 格子类型平面：只有入口（第0格）和出口（最后一格）不是0，分块写出
+    std::uint64_t typeBytes = MazeStorage::typeBytesFor(rows, cols);
+    std::uint64_t lastCell = static_cast<std::uint64_t>(rows) * cols - 1;
+    std::vector<std::uint8_t> chunk(std::min<std::uint64_t>(typeBytes, 1 << 16));
+    for (std::uint64_t offset = 0; offset < typeBytes && file; offset += chunk.size()) {
+        std::size_t length = static_cast<std::size_t>(std::min<std::uint64_t>(chunk.size(), typeBytes - offset));
+        std::fill(chunk.begin(), chunk.begin() + length, 0);
+        if (offset == 0) {
+            chunk[0] |= static_cast<std::uint8_t>(CellType::ENTRANCE);
+        }
+        if (lastCell / 4 >= offset && lastCell / 4 < offset + length) {
+            // 1×1的迷宫入口与出口重合，与Maze构造函数一样以出口为准
+            unsigned shift = (lastCell & 3) * 2;
+            std::uint8_t& byte = chunk[lastCell / 4 - offset];
+            byte = static_cast<std::uint8_t>((byte & ~(3u << shift)) | (static_cast<unsigned>(CellType::EXIT) << shift));
+        }
+        file.write(reinterpret_cast<const char*>(chunk.data()), length);
+    }
+
+    if (!file) {
+        std::cerr << "写入迷宫文件失败: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
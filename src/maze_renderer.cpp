@@ -0,0 +1,348 @@
+#include "maze_renderer.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+
+/**
+ * 终端迷宫渲染器的实现
+ * 输出与原来逐格打印的版本逐字节相同，只是先写进缓冲区再一次输出
+ */
+
+namespace {
+
+// 程序启动时std::cout的缓冲区；present据此判断std::cout是否仍指向控制台（批处理模式会把它换掉）
+std::streambuf* const consoleBuffer = std::cout.rdbuf();
+
+const char* const COLOR_RESET = "\033[0m";
+const char* const COLOR_TITLE = "\033[36m";
+
+const int LEFT = 1, RIGHT = 2, TOP = 4, BOTTOM = 8;
+
+// 与Visualizer::getConnector相同的规则
+const char* labeledJunction(int walls) {
+    switch (walls) {
+        case LEFT | RIGHT | TOP | BOTTOM: return "┼";
+        case RIGHT | TOP | BOTTOM:        return "├";
+        case LEFT | TOP | BOTTOM:         return "┤";
+        case LEFT | RIGHT | BOTTOM:       return "┬";
+        case LEFT | RIGHT | TOP:          return "┴";
+        case LEFT | RIGHT:                return "─";
+        case TOP | BOTTOM:                return "│";
+        case LEFT | TOP:                  return "┘";
+        case LEFT | BOTTOM:               return "┐";
+        case RIGHT | TOP:                 return "└";
+        case RIGHT | BOTTOM:              return "┌";
+        case LEFT: case RIGHT:            return "─";
+        case TOP: case BOTTOM:            return "│";
+        default:                          return " ";
+    }
+}
+
+// 与Maze::printMaze相同的规则
+const char* plainJunction(int walls) {
+    if (walls == (LEFT | RIGHT | TOP | BOTTOM)) return "┼";
+    if ((walls & LEFT) && (walls & RIGHT)) return "┬";
+    if ((walls & TOP) && (walls & BOTTOM)) return "┤";
+    if (walls & (LEFT | RIGHT)) return "─";
+    if (walls & (TOP | BOTTOM)) return "│";
+    return " ";
+}
+
+// 把字节串写到out处，返回写完后的位置（调用者保证缓冲区足够大）
+template <std::size_t N>
+char* put(char* out, const char (&text)[N]) {
+    std::memcpy(out, text, N - 1);
+    return out + N - 1;
+}
+
+char* put(char* out, const char* bytes, int length) {
+    std::memcpy(out, bytes, length);
+    return out + length;
+}
+
+template <typename Glyph>
+char* putGlyph(char* out, const Glyph& glyph) {
+    std::memcpy(out, glyph.bytes, sizeof(glyph.bytes));
+    return out + glyph.length;
+}
+
+// 横线段和竖线按有无墙查表，避免随机墙壁带来的分支预测失败
+struct RunGlyph {
+    char bytes[16];
+    int length;
+};
+const RunGlyph WALL_RUNS[2] = {{"   ", 3}, {"───", 9}};
+const RunGlyph BARS[2] = {{" ", 1}, {"│", 3}};
+
+char* putWallRun(char* out, bool wall) {
+    return putGlyph(out, WALL_RUNS[wall]);
+}
+
+char* putBar(char* out, bool wall) {
+    return putGlyph(out, BARS[wall]);
+}
+
+bool testBit(const std::uint64_t* bits, int i) {
+    return (bits[i >> 6] >> (i & 63)) & 1;
+}
+
+} // namespace
+
+MazeRenderer::MazeRenderer(Style style, bool useColors) : style(style), useColors(useColors) {
+    std::memset(junctions, 0, sizeof(junctions));
+    for (int walls = 0; walls < 16; walls++) {
+        const char* glyph = style == Style::LABELED ? labeledJunction(walls) : plainJunction(walls);
+        junctions[walls].length = static_cast<int>(std::strlen(glyph));
+        std::memcpy(junctions[walls].bytes, glyph, junctions[walls].length);
+    }
+    buildCellGlyphs();
+}
+
+void MazeRenderer::setUseColors(bool colors) {
+    if (colors == useColors) return;
+    useColors = colors;
+    buildCellGlyphs();
+}
+
+void MazeRenderer::buildCellGlyphs() {
+    // 与Visualizer::getCellSymbol相同：颜色只用于LABELED样式
+    bool colored = useColors && style == Style::LABELED;
+    const char* const symbols[4] = {"   ", " S ", " E ", " · "};
+    const char* const colors[4] = {"", "\033[42m\033[30m", "\033[41m\033[37m", "\033[43m\033[30m"};
+    std::memset(cells, 0, sizeof(cells));
+    for (int type = 0; type < 4; type++) {
+        std::string glyph = symbols[type];
+        if (colored && type != static_cast<int>(CellType::PATH)) glyph = colors[type] + glyph + COLOR_RESET;
+        cells[type].length = static_cast<int>(glyph.size());
+        std::memcpy(cells[type].bytes, glyph.data(), glyph.size());
+    }
+}
+
+std::size_t MazeRenderer::rowBound(int cols) const {
+    // 每格在内容行占一个格子字形和一根竖线，在墙壁行占一段横线和一个连接符，列号最多12字节；
+    // 每行另加行号、两端和换行
+    int maxCell = 0;
+    for (const Glyph& glyph : cells) maxCell = std::max(maxCell, glyph.length);
+    std::size_t perCell = static_cast<std::size_t>(maxCell) + 3 + 9 + 3 + 12;
+    return static_cast<std::size_t>(cols) * perCell + 64;
+}
+
+void MazeRenderer::render(const Maze& maze, const std::vector<Point>& path) {
+    int rows = maze.getRows();
+    int cols = maze.getCols();
+
+    bool hasOverlay = false;
+    for (const Point& p : path) {
+        if (maze.isValidPosition(p) && p != maze.getEntrance() && p != maze.getExit()) {
+            if (!hasOverlay) overlay.assign(static_cast<std::size_t>(rows) * cols, 0);
+            overlay[static_cast<std::size_t>(p.x) * cols + p.y] = 1;
+            hasOverlay = true;
+        }
+    }
+
+    // 上界：每行一份rowBound，再加标题和定长复制的余量；整帧画完才输出，flush什么也不做
+    std::size_t bound = static_cast<std::size_t>(rows + 2) * rowBound(cols) + 256 + sizeof(Glyph);
+    if (frame.size() < bound) frame.resize(bound);
+    char* end = draw(maze, frame.data(),
+        [&](int i) { return hasOverlay ? overlay.data() + static_cast<std::size_t>(i) * cols : nullptr; },
+        [](char*, char* end) { return end; });
+    frameLength = static_cast<std::size_t>(end - frame.data());
+
+    if (hasOverlay) {
+        for (const Point& p : path) {
+            if (maze.isValidPosition(p)) overlay[static_cast<std::size_t>(p.x) * cols + p.y] = 0;
+        }
+    }
+}
+
+void MazeRenderer::stream(const Maze& maze, const std::vector<Point>& path, std::ostream& out) {
+    int cols = maze.getCols();
+
+    // 路径格子按行优先的编号排序，画到第i行时只标记这一行的格子
+    std::vector<std::size_t> pathCells;
+    for (const Point& p : path) {
+        if (maze.isValidPosition(p) && p != maze.getEntrance() && p != maze.getExit()) {
+            pathCells.push_back(static_cast<std::size_t>(p.x) * cols + p.y);
+        }
+    }
+    std::sort(pathCells.begin(), pathCells.end());
+    rowMarks.assign(cols, 0);
+    std::size_t next = 0;
+    int markedRow = -1;
+
+    // 缓冲区只需容纳标题和一行，每画完一行就写出去
+    std::size_t bound = 2 * rowBound(cols) + 256 + sizeof(Glyph);
+    if (frame.size() < bound) frame.resize(bound);
+    draw(maze, frame.data(),
+        [&](int i) -> const std::uint8_t* {
+            if (markedRow >= 0) std::fill(rowMarks.begin(), rowMarks.end(), 0);
+            markedRow = -1;
+            std::size_t rowStart = static_cast<std::size_t>(i) * cols;
+            while (next < pathCells.size() && pathCells[next] < rowStart + cols) {
+                rowMarks[pathCells[next++] - rowStart] = 1;
+                markedRow = i;
+            }
+            return markedRow >= 0 ? rowMarks.data() : nullptr;
+        },
+        [&](char* begin, char* end) {
+            out.write(begin, end - begin);
+            return begin;
+        });
+    frameLength = 0;
+}
+
+template <typename RowOverlay, typename Flush>
+char* MazeRenderer::draw(const Maze& maze, char* base, RowOverlay rowOverlay, Flush flush) const {
+    const MazeStorage& storage = maze.getStorage();
+    int rows = maze.getRows();
+    int cols = maze.getCols();
+    bool labeled = style == Style::LABELED;
+    char* out = base;
+
+    if (labeled) {
+        out = put(out, "\n");
+        if (useColors) out = put(out, COLOR_TITLE, static_cast<int>(std::strlen(COLOR_TITLE)));
+        out = put(out, "迷宫结构（线段表示墙壁）：");
+        if (useColors) out = put(out, COLOR_RESET, static_cast<int>(std::strlen(COLOR_RESET)));
+        out = put(out, "\n\n    ");
+        for (int j = 0; j < cols; j++) {
+            out += std::snprintf(out, 16, "%4d", j);
+        }
+        out = put(out, "\n  ┌");
+    } else {
+        out = put(out, "\n迷宫结构（使用线段表示墙壁）：\n┌");
+    }
+
+    // 顶部边界
+    for (int j = 0; j < cols; j++) {
+        out = putWallRun(out, storage.topBorder(j));
+        if (j < cols - 1) out = put(out, "┬");
+    }
+    out = put(out, "┐\n");
+    out = flush(base, out);
+
+    for (int i = 0; i < rows; i++) {
+        const std::uint64_t* right = storage.rightRow(i);
+        const std::uint64_t* bottom = storage.bottomRow(i);
+
+        // 内容行：左边界、格子和右墙
+        if (labeled) out += std::snprintf(out, 16, "%2d", i);
+        out = putBar(out, storage.leftBorder(i));
+        const std::uint8_t* marks = rowOverlay(i);
+        for (int j = 0; j < cols; j++) {
+            const Glyph& cell = cells[marks && marks[j] ? static_cast<int>(CellType::VISITED) : storage.cellType(i, j)];
+            out = putGlyph(out, cell);
+            out = putBar(out, testBit(right, j));
+        }
+        out = put(out, "\n");
+        if (i == rows - 1) {
+            out = flush(base, out);
+            break;
+        }
+
+        // 墙壁行：第i行的下墙和第i、i+1行之间的交叉点
+        const std::uint64_t* nextRight = storage.rightRow(i + 1);
+        if (labeled) out = put(out, "  ");
+        bool horizontal = testBit(bottom, 0);
+        bool vertical = storage.leftBorder(i) || storage.leftBorder(i + 1);
+        if (labeled) {
+            out = horizontal && vertical ? put(out, "├") : horizontal ? put(out, "─") : putBar(out, vertical);
+        } else {
+            out = horizontal ? put(out, "├") : put(out, " ");
+        }
+        for (int j = 0; j < cols - 1; j++) {
+            bool wall = testBit(bottom, j);
+            out = putWallRun(out, wall);
+            const Glyph& junction = junctions[(wall ? LEFT : 0) | (testBit(bottom, j + 1) ? RIGHT : 0) |
+                                              (testBit(right, j) ? TOP : 0) | (testBit(nextRight, j) ? BOTTOM : 0)];
+            out = putGlyph(out, junction);
+        }
+        horizontal = testBit(bottom, cols - 1);
+        vertical = testBit(right, cols - 1) || testBit(nextRight, cols - 1);
+        out = putWallRun(out, horizontal);
+        out = horizontal && vertical ? put(out, "┤") : horizontal ? put(out, "─") : putBar(out, vertical);
+        out = put(out, "\n");
+        out = flush(base, out);
+    }
+
+    // 底部边界
+    out = labeled ? put(out, "  └") : put(out, "└");
+    const std::uint64_t* lastBottom = storage.bottomRow(rows - 1);
+    for (int j = 0; j < cols; j++) {
+        out = putWallRun(out, testBit(lastBottom, j));
+        if (j < cols - 1) out = put(out, "┴");
+    }
+    out = labeled ? put(out, "┘\n\n") : put(out, "┘\n");
+    return flush(base, out);
+}
+
+void MazeRenderer::present(std::ostream& out) const {
+    writeOut(out, frame.data(), frameLength);
+}
+
+void MazeRenderer::presentPatch(std::ostream& out) const {
+    writeOut(out, patch.data(), patch.size());
+}
+
+void MazeRenderer::writeOut(std::ostream& out, const char* data, std::size_t length) {
+    if (&out != &std::cout || std::cout.rdbuf() != consoleBuffer) {
+        out.write(data, static_cast<std::streamsize>(length));
+        return;
+    }
+    // 先把之前缓冲的提示文字送出去，保证顺序，然后整帧一次写出
+    std::cout.flush();
+    std::size_t written = 0;
+    while (written < length) {
+        ssize_t n = ::write(STDOUT_FILENO, data + written, length - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        written += static_cast<std::size_t>(n);
+    }
+}
+
+void MazeRenderer::beginAnimation(const std::string& status, int screenLines, int screenColumns) {
+    // 第1行是status，帧从第2行开始，最后一行留给endAnimation之后的输出
+    int shownLines = std::max(0, screenLines - 2);
+    std::size_t end = 0;
+    for (int line = 0; line < shownLines && end < frameLength; line++) {
+        const char* newline = static_cast<const char*>(std::memchr(frame.data() + end, '\n', frameLength - end));
+        end = newline ? static_cast<std::size_t>(newline - frame.data()) + 1 : frameLength;
+    }
+    animationLastLine = 1 + shownLines;
+    animationColumns = screenColumns;
+
+    // 关闭自动换行，过宽的行在屏幕右边截断而不是折到下一行，格子的屏幕位置才是确定的
+    patch.assign("\033[?7l\033[H\033[2J");
+    patch += status;
+    patch += "\n";
+    patch.append(frame.data(), end);
+}
+
+void MazeRenderer::renderPatch(const std::string& status, const Point* points, std::size_t count, CellType type) {
+    const Glyph& glyph = cells[static_cast<int>(type)];
+    char position[32];
+    patch.assign("\033[1;1H");
+    patch += status;
+    patch += "\033[K";
+    for (std::size_t i = 0; i < count; i++) {
+        // 第x行的内容位于帧的第6+2x行（帧第1行在屏幕第2行）；行号按%2d输出，超过两位时更宽
+        int x = points[i].x;
+        int labelWidth = 2;
+        for (int n = x; n >= 100; n /= 10) labelWidth++;
+        int line = 7 + 2 * x;
+        int column = labelWidth + 2 + 4 * points[i].y;
+        if (line > animationLastLine || column + 2 > animationColumns) continue;
+        patch.append(position, std::snprintf(position, sizeof(position), "\033[%d;%dH", line, column));
+        patch.append(glyph.bytes, glyph.length);
+    }
+}
+
+void MazeRenderer::endAnimation() {
+    char position[32];
+    patch.assign(position, std::snprintf(position, sizeof(position), "\033[%d;1H\033[?7h", animationLastLine + 1));
+}
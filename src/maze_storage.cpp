@@ -0,0 +1,99 @@
+#include "maze_storage.h"
+#include <algorithm>
+
+/**
+ * 紧凑迷宫存储的实现
+ */
+
+namespace {
+
+// 统计位串中前 n 位里1的个数
+std::size_t popcountPrefix(const std::uint64_t* bits, int n) {
+    std::size_t count = 0;
+    int fullWords = n >> 6;
+    for (int w = 0; w < fullWords; w++) {
+        count += __builtin_popcountll(bits[w]);
+    }
+    if (n & 63) {
+        std::uint64_t mask = (std::uint64_t(1) << (n & 63)) - 1;
+        count += __builtin_popcountll(bits[fullWords] & mask);
+    }
+    return count;
+}
+
+} // namespace
+
+MazeStorage::MazeStorage(int rows, int cols)
+    : rows(std::max(0, rows)), cols(std::max(0, cols)),
+      wordsPerRow((static_cast<std::size_t>(std::max(0, cols)) + 63) / 64) {
+    words.resize(wordCountFor(this->rows, this->cols));
+    types.resize(typeBytesFor(this->rows, this->cols));
+    wordBits = words.data();
+    typeBits = types.data();
+    reset();
+}
+
+MazeStorage::MazeStorage(const MazeStorage& other)
+    : rows(other.rows), cols(other.cols), wordsPerRow(other.wordsPerRow),
+      words(other.wordBits, other.wordBits + other.wordCount()),
+      types(other.typeBits, other.typeBits + other.typeBytes()),
+      wordBits(words.data()), typeBits(types.data()) {}
+
+MazeStorage& MazeStorage::operator=(const MazeStorage& other) {
+    if (this != &other) {
+        MazeStorage copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+MazeStorage MazeStorage::adopt(int rows, int cols, std::uint64_t* words, std::uint8_t* types,
+                               std::shared_ptr<void> owner) {
+    MazeStorage storage;
+    storage.rows = std::max(0, rows);
+    storage.cols = std::max(0, cols);
+    storage.wordsPerRow = (static_cast<std::size_t>(storage.cols) + 63) / 64;
+    storage.wordBits = words;
+    storage.typeBits = types;
+    storage.owner = std::move(owner);
+    return storage;
+}
+
+std::size_t MazeStorage::wordCountFor(int rows, int cols) {
+    rows = std::max(0, rows);
+    std::size_t perRow = (static_cast<std::size_t>(std::max(0, cols)) + 63) / 64;
+    std::size_t leftBorderWords = (static_cast<std::size_t>(rows) + 63) / 64;
+    return static_cast<std::size_t>(rows) * 2 * perRow + perRow + leftBorderWords;
+}
+
+std::size_t MazeStorage::typeBytesFor(int rows, int cols) {
+    return (static_cast<std::size_t>(std::max(0, rows)) * std::max(0, cols) + 3) / 4;
+}
+
+void MazeStorage::reset() {
+    std::fill(wordBits, wordBits + wordCount(), ~std::uint64_t(0));
+    std::fill(typeBits, typeBits + typeBytes(), 0);
+}
+
+std::size_t MazeStorage::countInteriorWalls() const {
+    std::size_t count = 0;
+    for (int x = 0; x < rows; x++) {
+        if (cols > 1) count += popcountPrefix(rightRow(x), cols - 1);
+        if (x < rows - 1) count += popcountPrefix(bottomRow(x), cols);
+    }
+    return count;
+}
+
+std::size_t MazeStorage::countBorderWalls() const {
+    if (rows == 0 || cols == 0) return 0;
+    std::size_t count = popcountPrefix(topBorderBits(), cols) + popcountPrefix(leftBorderBits(), rows);
+    count += popcountPrefix(bottomRow(rows - 1), cols);
+    for (int x = 0; x < rows; x++) {
+        count += rightWall(x, cols - 1);
+    }
+    return count;
+}
+
+std::size_t MazeStorage::memoryBytes() const {
+    return wordCount() * sizeof(std::uint64_t) + typeBytes();
+}
@@ -4,8 +4,7 @@
 #include <algorithm>
 #include <cmath>
 #include <map>
-#include <cstdlib>
-#include <ctime>
+#include <functional>
 
 // 颜色池（不含白色）
 static const std::vector<std::string> mondrian_colors = {
@@ -27,7 +26,7 @@ struct Block {
 };
 
 // 优先分割最大块，交替分割方向
-void splitBlocksMondrian(std::vector<Block>& blocks, int x, int y, int w, int h, int targetBlocks) {
+void splitBlocksMondrian(std::vector<Block>& blocks, int x, int y, int w, int h, int targetBlocks, Xoshiro256& rng) {
     struct QBlock { int x, y, w, h, depth; };
     std::vector<QBlock> q = { {x, y, w, h, 0} };
     while ((int)blocks.size() + (int)q.size() < targetBlocks) {
@@ -42,11 +41,11 @@ void splitBlocksMondrian(std::vector<Block>& blocks, int x, int y, int w, int h,
         if (blk.w > blk.h) splitVert = true;
         if (blk.h > blk.w) splitVert = false;
         if (splitVert && blk.w >= 120) {
-            int sw = 60 + rand() % (blk.w - 60);
+            int sw = 60 + rng.below(blk.w - 60);
             q.push_back({blk.x, blk.y, sw, blk.h, blk.depth+1});
             q.push_back({blk.x+sw, blk.y, blk.w-sw, blk.h, blk.depth+1});
         } else if (!splitVert && blk.h >= 120) {
-            int sh = 60 + rand() % (blk.h - 60);
+            int sh = 60 + rng.below(blk.h - 60);
             q.push_back({blk.x, blk.y, blk.w, sh, blk.depth+1});
             q.push_back({blk.x, blk.y+sh, blk.w, blk.h-sh, blk.depth+1});
         } else {
@@ -60,12 +59,12 @@ void splitBlocksMondrian(std::vector<Block>& blocks, int x, int y, int w, int h,
     }
 }
 
-MondrianMaze::MondrianMaze() {
-    srand(time(0));
+MondrianMaze::MondrianMaze(std::uint64_t seed) : seed(seed) {
+    Xoshiro256 rng(seed);
     while (true) {
         // 1. 生成色块
         std::vector<Block> blocks;
-        splitBlocksMondrian(blocks, 0, 0, 800, 800, 100); // 目标100块
+        splitBlocksMondrian(blocks, 0, 0, 800, 800, 100, rng); // 目标100块
         // 2. 转为Room
         rooms.clear();
         for (size_t i = 0; i < blocks.size(); ++i) {
@@ -0,0 +1,203 @@
+#include "pathfinder.h"
+#include "thread_pool.h"
+#include <chrono>
+
+/**
+ * 方向优化的并行BFS（Beamer算法）
+ * 1. 按层同步扩展，每层的工作在线程池中并行完成
+ * 2. 前沿较窄时自顶向下：遍历前沿列表，用原子位或抢占未访问的邻居
+ * 3. 前沿很宽时自底向上：遍历所有未访问格子，检查是否有邻居在前沿位图中；
+ *    每个线程只写自己负责的位图字，不需要原子操作
+ * 4. 访问标记、前沿都是以格子编号为下标的位图
+ */
+
+namespace {
+
+// 切换阈值（Beamer论文中的α、β）
+const int TOP_DOWN_TO_BOTTOM_UP = 14;   // 前沿 × α > 未访问格子数 时切换为自底向上
+const int BOTTOM_UP_TO_TOP_DOWN = 24;   // 前沿 × β < 格子总数 且前沿在缩小时切回自顶向下
+
+const int TOP_DOWN_CHUNK = 256;         // 自顶向下每块处理的前沿格子数
+const int BOTTOM_UP_CHUNK = 64;         // 自底向上每块处理的位图字数（64×64个格子）
+
+inline bool testBit(const std::vector<std::uint64_t>& bits, int i) {
+    return (bits[i >> 6] >> (i & 63)) & 1;
+}
+
+} // namespace
+
+ThreadPool& PathFinder::getThreadPool() {
+    if (!threadPool) {
+        threadPool = std::make_shared<ThreadPool>(threadCount);
+    }
+    return *threadPool;
+}
+
+void PathFinder::setThreadCount(int threads) {
+    if (threads != threadCount) {
+        threadCount = threads;
+        threadPool.reset();
+    }
+}
+
+PathFinder::SearchResult PathFinder::findPathParallelBFS(Maze& maze) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    SearchResult result;
+    result.algorithm = "并行BFS(方向优化)";
+
+    Point entrance = maze.getEntrance();
+    Point exit = maze.getExit();
+    if (!maze.isValidPosition(entrance) || !maze.isValidPosition(exit)) {
+        return result;
+    }
+
+    int cellCount = maze.getCellCount();
+    int source = maze.toIndex(entrance);
+    int target = maze.toIndex(exit);
+    if (static_cast<int>(parentIndex.size()) < cellCount) {
+        parentIndex.resize(cellCount);
+    }
+
+    bool found = false;
+    int visitedCount;
+    if (maze.isRectangularGrid()) {
+        visitedCount = parallelBfsSearch(cellCount, source, target,
+            [&maze](int index, int* out) { return maze.getGridNeighborIndices(index, out); }, found);
+    } else {
+        visitedCount = parallelBfsSearch(cellCount, source, target,
+            [&maze](int index, int* out) { return maze.getNeighborIndices(index, out); }, found);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    result.found = found;
+    result.visitedNodes = visitedCount;
+    result.searchTime = duration.count() / 1000.0;
+
+    if (found) {
+        result.path = buildPathFromParents(maze, source, target);
+        result.steps = result.path.size() - 1;
+    }
+
+    return result;
+}
+
+template <typename NeighborFn>
+int PathFinder::parallelBfsSearch(int cellCount, int source, int target, NeighborFn neighbors, bool& found) {
+    ThreadPool& pool = getThreadPool();
+    int slots = pool.size();
+    int wordCount = (cellCount + 63) / 64;
+
+    // 位图初始化；末尾超出格子总数的位预先标记为已访问，自底向上时不会被当作格子
+    visitedBits.assign(wordCount, 0);
+    frontierBits.assign(wordCount, 0);
+    nextBits.assign(wordCount, 0);
+    if (cellCount & 63) {
+        visitedBits[wordCount - 1] = ~std::uint64_t(0) << (cellCount & 63);
+    }
+    localFrontiers.resize(slots);
+    localCounts.assign(slots, 0);
+
+    frontierList.clear();
+    frontierList.push_back(source);
+    visitedBits[source >> 6] |= std::uint64_t(1) << (source & 63);
+    parentIndex[source] = source;
+
+    int visitedCount = 1;
+    int frontierSize = 1;
+    bool bottomUp = false;
+    found = (source == target);
+
+    while (frontierSize > 0 && !found) {
+        int unvisited = cellCount - visitedCount;
+
+        if (!bottomUp && static_cast<long long>(frontierSize) * TOP_DOWN_TO_BOTTOM_UP > unvisited) {
+            // 切换到自底向上：前沿列表转为位图
+            std::fill(frontierBits.begin(), frontierBits.end(), 0);
+            for (int u : frontierList) {
+                frontierBits[u >> 6] |= std::uint64_t(1) << (u & 63);
+            }
+            bottomUp = true;
+        }
+
+        int nextSize = 0;
+        if (bottomUp) {
+            // 自底向上：每个未访问格子检查邻居是否在当前前沿中
+            std::fill(localCounts.begin(), localCounts.end(), 0);
+            pool.parallelFor(wordCount, [&](int begin, int end, int slot) {
+                int adjacent[NeighborList::CAPACITY];
+                int added = 0;
+                for (int w = begin; w < end; w++) {
+                    std::uint64_t pendingBits = ~visitedBits[w];
+                    std::uint64_t newBits = 0;
+                    while (pendingBits) {
+                        int bit = __builtin_ctzll(pendingBits);
+                        pendingBits &= pendingBits - 1;
+                        int v = w * 64 + bit;
+                        int count = neighbors(v, adjacent);
+                        for (int k = 0; k < count; k++) {
+                            if (testBit(frontierBits, adjacent[k])) {
+                                parentIndex[v] = adjacent[k];
+                                newBits |= std::uint64_t(1) << bit;
+                                break;
+                            }
+                        }
+                    }
+                    nextBits[w] = newBits;
+                    visitedBits[w] |= newBits;
+                    added += __builtin_popcountll(newBits);
+                }
+                localCounts[slot] += added;
+            }, BOTTOM_UP_CHUNK);
+            for (int c : localCounts) nextSize += c;
+            frontierBits.swap(nextBits);
+
+            if (static_cast<long long>(nextSize) * BOTTOM_UP_TO_TOP_DOWN < cellCount && nextSize < frontierSize) {
+                // 前沿重新变窄：位图转回列表，切回自顶向下
+                frontierList.clear();
+                for (int w = 0; w < wordCount; w++) {
+                    std::uint64_t bits = frontierBits[w];
+                    while (bits) {
+                        frontierList.push_back(w * 64 + __builtin_ctzll(bits));
+                        bits &= bits - 1;
+                    }
+                }
+                bottomUp = false;
+            }
+        } else {
+            // 自顶向下：遍历前沿列表，用原子位或抢占未访问的邻居
+            for (auto& local : localFrontiers) local.clear();
+            pool.parallelFor(frontierSize, [&](int begin, int end, int slot) {
+                int adjacent[NeighborList::CAPACITY];
+                std::vector<int>& out = localFrontiers[slot];
+                for (int i = begin; i < end; i++) {
+                    int u = frontierList[i];
+                    int count = neighbors(u, adjacent);
+                    for (int k = 0; k < count; k++) {
+                        int v = adjacent[k];
+                        std::uint64_t mask = std::uint64_t(1) << (v & 63);
+                        std::uint64_t* word = &visitedBits[v >> 6];
+                        if (__atomic_load_n(word, __ATOMIC_RELAXED) & mask) continue;
+                        if (!(__atomic_fetch_or(word, mask, __ATOMIC_RELAXED) & mask)) {
+                            parentIndex[v] = u;
+                            out.push_back(v);
+                        }
+                    }
+                }
+            }, TOP_DOWN_CHUNK);
+            frontierList.clear();
+            for (const auto& local : localFrontiers) {
+                frontierList.insert(frontierList.end(), local.begin(), local.end());
+            }
+            nextSize = static_cast<int>(frontierList.size());
+        }
+
+        visitedCount += nextSize;
+        frontierSize = nextSize;
+        found = testBit(visitedBits, target);
+    }
+
+    return visitedCount;
+}
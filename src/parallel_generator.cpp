@@ -0,0 +1,124 @@
+#include "maze.h"
+#include "thread_pool.h"
+#include "disjoint_set.h"
+#include <algorithm>
+
+/**
+ * 并行分块生成完美迷宫
+ * 1. 迷宫按TILE_ROWS × TILE_COLS切成若干块，块宽是64的倍数，每块只写自己的墙壁字，
+ *    各线程之间没有共享的写入位置，不需要加锁
+ * 2. 每块内部做随机Kruskal：打乱块内的所有内墙，用并查集拆掉连接两个不同集合的墙，
+ *    得到块内的一棵生成树
+ * 3. 拼接：把相邻块之间的边界看作块图上的边，打乱后再做一次Kruskal，每条选中的边界
+ *    随机打开一面墙。块内是树、块之间也是树，整体仍然是完美迷宫
+ * 4. 第t块使用由seed出发jump() t+1次得到的子序列（拼接用最后一个），与块被哪个线程、
+ *    以什么顺序处理无关，因此同一个seed在任意线程数下都生成相同的迷宫
+ */
+
+namespace {
+
+const int TILE_ROWS = 256;
+const int TILE_COLS = 256;   // 必须是64的倍数，保证不同块不共享墙壁字
+
+// 每个线程复用的缓冲区
+struct TileScratch {
+    std::vector<int> edges;   // 块内墙编号：局部格子编号 * 2 + (0右墙 / 1下墙)
+    DisjointSet sets;
+};
+
+} // namespace
+
+void Maze::generateParallel(std::uint64_t seed, int threadCount) {
+    // 直接改写位平面依赖矩形网格布局，其它形状交给各自的生成算法
+    if (!isRectangularGrid()) {
+        generate();
+        return;
+    }
+
+    setSeed(seed);
+    storage.reset();
+    wallsChanged();
+
+    int tileRowCount = (rows + TILE_ROWS - 1) / TILE_ROWS;
+    int tileColCount = (cols + TILE_COLS - 1) / TILE_COLS;
+    int tileCount = tileRowCount * tileColCount;
+
+    // 每块一个互不重叠的随机子序列，最后一个留给拼接
+    std::vector<Xoshiro256> streams(tileCount + 1);
+    Xoshiro256 stream(seed);
+    for (Xoshiro256& tileStream : streams) {
+        stream.jump();
+        tileStream = stream;
+    }
+
+    ThreadPool pool(threadCount);
+    std::vector<TileScratch> scratch(pool.size());
+
+    pool.parallelFor(tileCount, [&](int begin, int end, int slot) {
+        TileScratch& buffers = scratch[slot];
+        for (int tile = begin; tile < end; tile++) {
+            int top = (tile / tileColCount) * TILE_ROWS;
+            int left = (tile % tileColCount) * TILE_COLS;
+            int height = std::min(TILE_ROWS, rows - top);
+            int width = std::min(TILE_COLS, cols - left);
+
+            // 块内的墙：最后一列没有块内右墙，最后一行没有块内下墙
+            buffers.edges.clear();
+            for (int i = 0; i < height; i++) {
+                for (int j = 0; j < width; j++) {
+                    int local = i * width + j;
+                    if (j + 1 < width) buffers.edges.push_back(local * 2);
+                    if (i + 1 < height) buffers.edges.push_back(local * 2 + 1);
+                }
+            }
+            streams[tile].shuffle(buffers.edges.begin(), buffers.edges.end());
+
+            buffers.sets.reset(height * width);
+            int remaining = height * width - 1;
+            for (int edge : buffers.edges) {
+                if (remaining == 0) break;
+                int local = edge >> 1;
+                bool bottom = edge & 1;
+                if (!buffers.sets.unite(local, bottom ? local + width : local + 1)) continue;
+                int x = top + local / width, y = left + local % width;
+                if (bottom) {
+                    storage.setBottomWall(x, y, false);
+                } else {
+                    storage.setRightWall(x, y, false);
+                }
+                remaining--;
+            }
+        }
+    }, 1);
+
+    // 块之间的拼接：块图上的边编号为 块编号 * 2 + (0右邻块 / 1下邻块)
+    std::vector<int> borders;
+    for (int tile = 0; tile < tileCount; tile++) {
+        if (tile % tileColCount + 1 < tileColCount) borders.push_back(tile * 2);
+        if (tile / tileColCount + 1 < tileRowCount) borders.push_back(tile * 2 + 1);
+    }
+    Xoshiro256& stitchRng = streams[tileCount];
+    stitchRng.shuffle(borders.begin(), borders.end());
+
+    DisjointSet tiles;
+    tiles.reset(tileCount);
+    for (int border : borders) {
+        int tile = border >> 1;
+        bool bottom = border & 1;
+        if (!tiles.unite(tile, bottom ? tile + tileColCount : tile + 1)) continue;
+
+        int top = (tile / tileColCount) * TILE_ROWS;
+        int left = (tile % tileColCount) * TILE_COLS;
+        int height = std::min(TILE_ROWS, rows - top);
+        int width = std::min(TILE_COLS, cols - left);
+        if (bottom) {
+            storage.setBottomWall(top + height - 1, left + static_cast<int>(stitchRng.below(width)), false);
+        } else {
+            storage.setRightWall(top + static_cast<int>(stitchRng.below(height)), left + width - 1, false);
+        }
+    }
+
+    // 设置入口出口类型
+    setCellType(entrance, CellType::ENTRANCE);
+    setCellType(exit, CellType::EXIT);
+}
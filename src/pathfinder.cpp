@@ -1,4 +1,5 @@
 #include "pathfinder.h"
+#include "tree_index.h"
 #include <chrono>
 #include <iostream>
 #include <iomanip>
@@ -6,109 +7,182 @@
 
 /**
  * 路径寻找器的实现
- * 实现了DFS、BFS和A*三种路径寻找算法
+ * 实现了DFS、BFS和A*三种路径寻找算法，以及完美迷宫的树索引查询（双向搜索见bidirectional_search.cpp）
  */
 
 PathFinder::SearchResult PathFinder::findPathDFS(Maze& maze) {
+    NullSearchObserver observer;
+    return findPathDFS(maze, observer);
+}
+
+template <typename Observer>
+PathFinder::SearchResult PathFinder::findPathDFS(Maze& maze, Observer& observer) {
     auto start = std::chrono::high_resolution_clock::now();
     
     SearchResult result;
     result.algorithm = "深度优先搜索(DFS)";
     
-    // 创建访问标记矩阵
-    std::vector<std::vector<bool>> visited(maze.getRows(), 
-                                         std::vector<bool>(maze.getCols(), false));
-    
-    std::vector<Point> path;
-    int visitedCount = 0;
+    prepareObserver(observer, maze.getCellCount());
     
     // 从入口开始搜索
     Point entrance = maze.getEntrance();
     Point exit = maze.getExit();
+    if (!maze.isValidPosition(entrance) || !maze.isValidPosition(exit)) {
+        return result;
+    }
     
-    bool found = dfsHelper(maze, entrance, exit, path, visited, visitedCount);
+    beginSearch(maze.getCellCount());
+    int source = maze.toIndex(entrance);
+    int target = maze.toIndex(exit);
+    
+    bool found = false;
+    int visitedCount;
+    if (maze.isRectangularGrid()) {
+        visitedCount = dfsSearch(source, target,
+            [&maze](int index, int* out) { return maze.getGridNeighborIndices(index, out); }, observer, found);
+    } else {
+        visitedCount = dfsSearch(source, target,
+            [&maze](int index, int* out) { return maze.getNeighborIndices(index, out); }, observer, found);
+    }
     
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
     
     result.found = found;
-    result.path = path;
-    result.steps = found ? path.size() - 1 : 0;
+    if (found) {
+        // 找到终点时栈中自底向上恰好是从入口到出口的路径
+        result.path.reserve(dfsStack.size());
+        for (const DfsFrame& frame : dfsStack) {
+            result.path.push_back(maze.fromIndex(frame.cell));
+        }
+    }
+    result.steps = found ? result.path.size() - 1 : 0;
     result.visitedNodes = visitedCount;
     result.searchTime = duration.count() / 1000.0;
     
     return result;
 }
 
-bool PathFinder::dfsHelper(Maze& maze, const Point& current, const Point& target,
-                          std::vector<Point>& path, std::vector<std::vector<bool>>& visited,
-                          int& visitedCount) {
-    // 标记当前点为已访问
-    visited[current.x][current.y] = true;
-    visitedCount++;
-    path.push_back(current);
-    
-    // 如果到达目标点
-    if (current == target) {
-        return true;
+void PathFinder::pushDfsFrame(int cell) {
+    dfsStack.emplace_back();
+    dfsStack.back().cell = cell;
+}
+
+template <typename NeighborFn, typename Observer>
+int PathFinder::dfsSearch(int source, int target, NeighborFn neighbors, Observer& observer, bool& found) {
+    // 显式栈模拟递归：每帧保存格子、进入时取得的邻居列表和下一个要尝试的邻居，
+    // 访问顺序与递归版本完全相同，栈深度只受堆内存限制
+    dfsStack.clear();
+    found = false;
+    
+    markVisited(source);
+    pushDfsFrame(source);
+    observer.onDiscover(source);
+    observer.onExpand(source, 1);
+    int visitedCount = 1;
+    if (source == target) {
+        found = true;
+        return visitedCount;
+    }
+    dfsStack.back().count = neighbors(source, dfsStack.back().adjacent);
+    
+    while (!dfsStack.empty()) {
+        DfsFrame& frame = dfsStack.back();
+        if (frame.next == frame.count) {
+            // 所有邻居都已尝试，回溯
+            dfsStack.pop_back();
+            continue;
+        }
+        
+        int next = frame.adjacent[frame.next++];
+        if (isVisited(next)) {
+            continue;
+        }
+        
+        markVisited(next);
+        visitedCount++;
+        pushDfsFrame(next);  // 可能导致扩容，此后不能再使用frame引用
+        observer.onDiscover(next);
+        observer.onExpand(next, static_cast<int>(dfsStack.size()));
+        if (next == target) {
+            found = true;
+            break;
+        }
+        dfsStack.back().count = neighbors(next, dfsStack.back().adjacent);
     }
+    return visitedCount;
+}
+
+template <typename NeighborFn, typename Observer>
+int PathFinder::bfsSearch(int source, int target, NeighborFn neighbors, Observer& observer, bool& found) {
+    frontier.push(source);
+    markVisited(source);
+    observer.onDiscover(source);
+    parentIndex[source] = source;
+    int visitedCount = 1;
     
-    // 获取所有可访问的邻居
-    std::vector<Point> neighbors = maze.getAccessibleNeighbors(current);
+    found = false;
+    int adjacent[NeighborList::CAPACITY];
     
-    for (const auto& neighbor : neighbors) {
-        if (!visited[neighbor.x][neighbor.y]) {
-            if (dfsHelper(maze, neighbor, target, path, visited, visitedCount)) {
-                return true;
+    while (!frontier.empty()) {
+        int current = frontier.pop();
+        observer.onExpand(current, static_cast<int>(frontier.size()));
+        
+        if (current == target) {
+            found = true;
+            break;
+        }
+        
+        // 访问所有邻居
+        int count = neighbors(current, adjacent);
+        for (int k = 0; k < count; k++) {
+            int next = adjacent[k];
+            if (!isVisited(next)) {
+                markVisited(next);
+                observer.onDiscover(next);
+                visitedCount++;
+                parentIndex[next] = current;
+                frontier.push(next);
             }
         }
     }
-    
-    // 回溯
-    path.pop_back();
-    return false;
+    return visitedCount;
 }
 
 PathFinder::SearchResult PathFinder::findPathBFS(Maze& maze) {
+    NullSearchObserver observer;
+    return findPathBFS(maze, observer);
+}
+
+template <typename Observer>
+PathFinder::SearchResult PathFinder::findPathBFS(Maze& maze, Observer& observer) {
     auto start = std::chrono::high_resolution_clock::now();
     
     SearchResult result;
     result.algorithm = "广度优先搜索(BFS)";
     
+    prepareObserver(observer, maze.getCellCount());
+    
     Point entrance = maze.getEntrance();
     Point exit = maze.getExit();
+    if (!maze.isValidPosition(entrance) || !maze.isValidPosition(exit)) {
+        return result;
+    }
     
-    // BFS队列
-    std::queue<Point> queue;
-    std::vector<std::vector<bool>> visited(maze.getRows(), 
-                                         std::vector<bool>(maze.getCols(), false));
-    std::unordered_map<Point, Point, PointHash> parent;
-    
-    queue.push(entrance);
-    visited[entrance.x][entrance.y] = true;
-    int visitedCount = 1;
+    // 使用稠密格子编号：父节点和访问标记都是平铺数组，前沿是环形队列
+    beginSearch(maze.getCellCount());
+    int source = maze.toIndex(entrance);
+    int target = maze.toIndex(exit);
     
     bool found = false;
-    
-    while (!queue.empty() && !found) {
-        Point current = queue.front();
-        queue.pop();
-        
-        if (current == exit) {
-            found = true;
-            break;
-        }
-        
-        // 访问所有邻居
-        std::vector<Point> neighbors = maze.getAccessibleNeighbors(current);
-        for (const auto& neighbor : neighbors) {
-            if (!visited[neighbor.x][neighbor.y]) {
-                visited[neighbor.x][neighbor.y] = true;
-                visitedCount++;
-                parent[neighbor] = current;
-                queue.push(neighbor);
-            }
-        }
+    int visitedCount;
+    if (maze.isRectangularGrid()) {
+        // 矩形网格直接内联读取墙壁位，省去每个格子一次虚函数调用
+        visitedCount = bfsSearch(source, target,
+            [&maze](int index, int* out) { return maze.getGridNeighborIndices(index, out); }, observer, found);
+    } else {
+        visitedCount = bfsSearch(source, target,
+            [&maze](int index, int* out) { return maze.getNeighborIndices(index, out); }, observer, found);
     }
     
     auto end = std::chrono::high_resolution_clock::now();
@@ -119,86 +193,146 @@ PathFinder::SearchResult PathFinder::findPathBFS(Maze& maze) {
     result.searchTime = duration.count() / 1000.0;
     
     if (found) {
-        // 重构路径
-        std::vector<Point> path;
-        Point current = exit;
+        result.path = buildPathFromParents(maze, source, target);
+        result.steps = result.path.size() - 1;
+    }
+    
+    return result;
+}
+
+void PathFinder::beginSearch(int cellCount) {
+    if (static_cast<int>(parentIndex.size()) < cellCount) {
+        parentIndex.resize(cellCount);
+    }
+    if (static_cast<int>(visitMark.size()) < cellCount) {
+        visitMark.assign(cellCount, 0);
+        std::fill(backwardMark.begin(), backwardMark.end(), 0);
+        currentMark = 0;
+    }
+    frontier.clear();
+    
+    // 标记计数器回绕时才需要真正清空访问标记（反向标记共用同一个计数器）
+    if (++currentMark == 0) {
+        std::fill(visitMark.begin(), visitMark.end(), 0);
+        std::fill(backwardMark.begin(), backwardMark.end(), 0);
+        currentMark = 1;
+    }
+}
+
+std::vector<Point> PathFinder::buildPathFromParents(const Maze& maze, int start, int goal) const {
+    // 先数出路径长度，一次分配到位后倒序填充
+    size_t length = 1;
+    for (int cur = goal; cur != start; cur = parentIndex[cur]) {
+        length++;
+    }
+    
+    std::vector<Point> path(length);
+    int cur = goal;
+    for (size_t i = length; i-- > 0; ) {
+        path[i] = maze.fromIndex(cur);
+        cur = parentIndex[cur];
+    }
+    return path;
+}
+
+template <typename NeighborFn, typename HeuristicFn, typename Observer>
+int PathFinder::astarSearch(int source, int target, NeighborFn neighbors, HeuristicFn heuristic, Observer& observer,
+                            bool& found) {
+    // 堆键值：高32位为f = g + h，低32位为h；f相同时优先扩展离终点更近的格子
+    auto makeKey = [](int g, int h) {
+        return (static_cast<std::int64_t>(g + h) << 32) | static_cast<std::uint32_t>(h);
+    };
+    
+    markVisited(source);
+    observer.onDiscover(source);
+    gCost[source] = 0;
+    parentIndex[source] = source;
+    openHeap.pushOrDecrease(source, makeKey(0, heuristic(source)));
+    
+    int visitedCount = 0;
+    found = false;
+    int adjacent[NeighborList::CAPACITY];
+    
+    while (!openHeap.empty()) {
+        int current = openHeap.pop();
+        visitedCount++;
+        observer.onExpand(current, openHeap.size());
         
-        while (!(current == entrance)) {
-            path.push_back(current);
-            current = parent[current];
+        if (current == target) {
+            found = true;
+            break;
         }
-        path.push_back(entrance);
         
-        std::reverse(path.begin(), path.end());
-        result.path = path;
-        result.steps = path.size() - 1;
+        int newGCost = gCost[current] + 1;
+        int count = neighbors(current, adjacent);
+        for (int k = 0; k < count; k++) {
+            int next = adjacent[k];
+            if (!isVisited(next)) {
+                // 第一次发现该格子
+                markVisited(next);
+                observer.onDiscover(next);
+                gCost[next] = newGCost;
+                parentIndex[next] = current;
+                openHeap.pushOrDecrease(next, makeKey(newGCost, heuristic(next)));
+            } else if (openHeap.contains(next) && newGCost < gCost[next]) {
+                // 仍在开放列表中且找到更短的路径：decrease-key
+                // （已出堆的格子视为关闭；启发式满足一致性，不需要重新打开）
+                gCost[next] = newGCost;
+                parentIndex[next] = current;
+                openHeap.pushOrDecrease(next, makeKey(newGCost, heuristic(next)));
+            }
+        }
     }
     
-    return result;
+    openHeap.clear();
+    return visitedCount;
 }
 
 PathFinder::SearchResult PathFinder::findPathAStar(Maze& maze) {
+    NullSearchObserver observer;
+    return findPathAStar(maze, observer);
+}
+
+template <typename Observer>
+PathFinder::SearchResult PathFinder::findPathAStar(Maze& maze, Observer& observer) {
     auto start = std::chrono::high_resolution_clock::now();
     
     SearchResult result;
     result.algorithm = "A*算法";
     
+    int cellCount = maze.getCellCount();
+    prepareObserver(observer, cellCount);
+    
     Point entrance = maze.getEntrance();
     Point exit = maze.getExit();
+    if (!maze.isValidPosition(entrance) || !maze.isValidPosition(exit)) {
+        return result;
+    }
     
-    // A*算法的开放列表和关闭列表
-    std::priority_queue<AStarNode, std::vector<AStarNode>, std::greater<AStarNode>> openList;
-    std::unordered_map<Point, int, PointHash> closedList;
-    std::unordered_map<Point, AStarNode*, PointHash> nodeMap;
+    beginSearch(cellCount);
+    if (static_cast<int>(gCost.size()) < cellCount) {
+        gCost.resize(cellCount);
+    }
+    openHeap.reserveIds(cellCount);
     
-    // 创建起始节点
-    AStarNode* startNode = new AStarNode(entrance, 0, manhattanDistance(entrance, exit));
-    openList.push(*startNode);
-    nodeMap[entrance] = startNode;
+    int source = maze.toIndex(entrance);
+    int target = maze.toIndex(exit);
     
-    int visitedCount = 0;
     bool found = false;
-    AStarNode* endNode = nullptr;
-    
-    while (!openList.empty() && !found) {
-        AStarNode current = openList.top();
-        openList.pop();
-        
-        // 如果该节点已经在关闭列表中，跳过
-        if (closedList.find(current.point) != closedList.end()) {
-            continue;
-        }
-        
-        // 将当前节点加入关闭列表
-        closedList[current.point] = current.fCost;
-        visitedCount++;
-        
-        // 如果到达目标
-        if (current.point == exit) {
-            found = true;
-            endNode = nodeMap[current.point];
-            break;
-        }
-        
-        // 检查所有邻居
-        std::vector<Point> neighbors = maze.getAccessibleNeighbors(current.point);
-        for (const auto& neighbor : neighbors) {
-            // 如果邻居在关闭列表中，跳过
-            if (closedList.find(neighbor) != closedList.end()) {
-                continue;
-            }
-            
-            int newGCost = current.gCost + 1;
-            int hCost = manhattanDistance(neighbor, exit);
-            
-            // 如果邻居不在开放列表中，或者找到了更短的路径
-            auto it = nodeMap.find(neighbor);
-            if (it == nodeMap.end() || newGCost < it->second->gCost) {
-                AStarNode* neighborNode = new AStarNode(neighbor, newGCost, hCost, nodeMap[current.point]);
-                nodeMap[neighbor] = neighborNode;
-                openList.push(*neighborNode);
-            }
-        }
+    int visitedCount;
+    if (maze.isRectangularGrid()) {
+        // 矩形网格：邻居和启发式都直接由编号计算，不经过虚函数
+        int cols = maze.getCols();
+        visitedCount = astarSearch(source, target,
+            [&maze](int index, int* out) { return maze.getGridNeighborIndices(index, out); },
+            [cols, &exit](int index) {
+                int x = index / cols;
+                return std::abs(x - exit.x) + std::abs(index - x * cols - exit.y);
+            }, observer, found);
+    } else {
+        visitedCount = astarSearch(source, target,
+            [&maze](int index, int* out) { return maze.getNeighborIndices(index, out); },
+            [&maze, target](int index) { return maze.getDistanceLowerBound(index, target); }, observer, found);
     }
     
     auto end = std::chrono::high_resolution_clock::now();
@@ -208,76 +342,120 @@ PathFinder::SearchResult PathFinder::findPathAStar(Maze& maze) {
     result.visitedNodes = visitedCount;
     result.searchTime = duration.count() / 1000.0;
     
-    if (found && endNode) {
-        result.path = reconstructPath(endNode);
+    if (found) {
+        result.path = buildPathFromParents(maze, source, target);
         result.steps = result.path.size() - 1;
     }
     
-    // 清理内存
-    for (auto& pair : nodeMap) {
-        delete pair.second;
-    }
-    
     return result;
 }
 
-int PathFinder::manhattanDistance(const Point& a, const Point& b) {
-    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
-}
-
-std::vector<Point> PathFinder::reconstructPath(AStarNode* endNode) {
-    std::vector<Point> path;
-    AStarNode* current = endNode;
+PathFinder::SearchResult PathFinder::findPathTree(Maze& maze) {
+    std::shared_ptr<const TreeIndex> index = maze.getTreeIndex();
+    if (!index->isTree()) {
+        // 有环或不连通时路径不唯一，退化为BFS
+        SearchResult result = findPathBFS(maze);
+        result.algorithm = "树索引(非完美迷宫,退化为BFS)";
+        return result;
+    }
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    
+    SearchResult result;
+    result.algorithm = "树索引(完美迷宫)";
+    
+    Point entrance = maze.getEntrance();
+    Point exit = maze.getExit();
+    if (!maze.isValidPosition(entrance) || !maze.isValidPosition(exit)) {
+        return result;
+    }
     
-    while (current != nullptr) {
-        path.push_back(current->point);
-        current = current->parent;
+    std::vector<int> cells = index->path(maze.toIndex(entrance), maze.toIndex(exit));
+    result.path.reserve(cells.size());
+    for (int cell : cells) {
+        result.path.push_back(maze.fromIndex(cell));
     }
     
-    std::reverse(path.begin(), path.end());
-    return path;
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    
+    result.found = true;
+    result.steps = result.path.size() - 1;
+    result.visitedNodes = result.path.size();   // 只沿父指针走过路径上的格子
+    result.searchTime = duration.count() / 1000.0;
+    
+    return result;
+}
+
+int PathFinder::treeDistance(const Maze& maze, const Point& a, const Point& b) {
+    if (!maze.isValidPosition(a) || !maze.isValidPosition(b)) return -1;
+    std::shared_ptr<const TreeIndex> index = maze.getTreeIndex();
+    if (!index->isTree()) return -1;
+    return index->distance(maze.toIndex(a), maze.toIndex(b));
 }
 
 std::vector<std::vector<Point>> PathFinder::findAllPaths(Maze& maze, int maxPaths) {
     std::vector<std::vector<Point>> allPaths;
-    std::vector<Point> currentPath;
-    std::vector<std::vector<bool>> visited(maze.getRows(), 
-                                         std::vector<bool>(maze.getCols(), false));
     
     Point entrance = maze.getEntrance();
     Point exit = maze.getExit();
+    if (!maze.isValidPosition(entrance) || !maze.isValidPosition(exit) || maxPaths <= 0) {
+        return allPaths;
+    }
     
-    findAllPathsDFS(maze, entrance, exit, currentPath, allPaths, visited, maxPaths);
+    beginSearch(maze.getCellCount());
+    int source = maze.toIndex(entrance);
+    int target = maze.toIndex(exit);
+    
+    if (maze.isRectangularGrid()) {
+        enumeratePaths(maze, source, target, maxPaths, allPaths,
+            [&maze](int index, int* out) { return maze.getGridNeighborIndices(index, out); });
+    } else {
+        enumeratePaths(maze, source, target, maxPaths, allPaths,
+            [&maze](int index, int* out) { return maze.getNeighborIndices(index, out); });
+    }
     
     return allPaths;
 }
 
-void PathFinder::findAllPathsDFS(Maze& maze, const Point& current, const Point& target,
-                                std::vector<Point>& currentPath, 
-                                std::vector<std::vector<Point>>& allPaths,
-                                std::vector<std::vector<bool>>& visited,
-                                int maxPaths) {
-    if (allPaths.size() >= maxPaths) {
-        return;
-    }
-    
-    visited[current.x][current.y] = true;
-    currentPath.push_back(current);
-    
-    if (current == target) {
-        allPaths.push_back(currentPath);
-    } else {
-        std::vector<Point> neighbors = maze.getAccessibleNeighbors(current);
-        for (const auto& neighbor : neighbors) {
-            if (!visited[neighbor.x][neighbor.y]) {
-                findAllPathsDFS(maze, neighbor, target, currentPath, allPaths, visited, maxPaths);
+template <typename NeighborFn>
+void PathFinder::enumeratePaths(const Maze& maze, int source, int target, int maxPaths,
+                                std::vector<std::vector<Point>>& allPaths, NeighborFn neighbors) {
+    // 与findPathDFS相同的显式栈；区别是回溯时清除访问标记，
+    // 使同一个格子可以出现在不同的路径上
+    dfsStack.clear();
+    
+    auto enter = [&](int cell) {
+        markVisited(cell);
+        pushDfsFrame(cell);
+        if (cell == target) {
+            // 记录当前路径；终点不再向外扩展
+            std::vector<Point> path;
+            path.reserve(dfsStack.size());
+            for (const DfsFrame& frame : dfsStack) {
+                path.push_back(maze.fromIndex(frame.cell));
             }
+            allPaths.push_back(std::move(path));
+        } else {
+            dfsStack.back().count = neighbors(cell, dfsStack.back().adjacent);
+        }
+    };
+    
+    enter(source);
+    while (!dfsStack.empty() && static_cast<int>(allPaths.size()) < maxPaths) {
+        DfsFrame& frame = dfsStack.back();
+        if (frame.next == frame.count) {
+            // 回溯
+            unmarkVisited(frame.cell);
+            dfsStack.pop_back();
+            continue;
+        }
+        
+        int next = frame.adjacent[frame.next++];
+        if (!isVisited(next)) {
+            enter(next);
         }
     }
-    
-    // 回溯
-    currentPath.pop_back();
-    visited[current.x][current.y] = false;
 }
 
 void PathFinder::compareAlgorithms(Maze& maze) {
@@ -289,35 +467,27 @@ void PathFinder::compareAlgorithms(Maze& maze) {
               << std::setw(12) << "搜索时间(ms)" << std::endl;
     std::cout << std::string(59, '-') << std::endl;
     
-    // 测试DFS
-    Maze mazeCopy1 = maze.clone();
-    SearchResult dfsResult = findPathDFS(mazeCopy1);
-    std::cout << std::setw(15) << dfsResult.algorithm
-              << std::setw(10) << (dfsResult.found ? "是" : "否")
-              << std::setw(10) << dfsResult.steps
-              << std::setw(12) << dfsResult.visitedNodes
-              << std::setw(12) << std::fixed << std::setprecision(3) << dfsResult.searchTime
-              << std::endl;
-    
-    // 测试BFS
-    Maze mazeCopy2 = maze.clone();
-    SearchResult bfsResult = findPathBFS(mazeCopy2);
-    std::cout << std::setw(15) << bfsResult.algorithm
-              << std::setw(10) << (bfsResult.found ? "是" : "否")
-              << std::setw(10) << bfsResult.steps
-              << std::setw(12) << bfsResult.visitedNodes
-              << std::setw(12) << std::fixed << std::setprecision(3) << bfsResult.searchTime
-              << std::endl;
-    
-    // 测试A*
-    Maze mazeCopy3 = maze.clone();
-    SearchResult astarResult = findPathAStar(mazeCopy3);
-    std::cout << std::setw(15) << astarResult.algorithm
-              << std::setw(10) << (astarResult.found ? "是" : "否")
-              << std::setw(10) << astarResult.steps
-              << std::setw(12) << astarResult.visitedNodes
-              << std::setw(12) << std::fixed << std::setprecision(3) << astarResult.searchTime
-              << std::endl;
+    // 求解不会修改迷宫，直接在原迷宫上运行（clone()会把圆形迷宫切片成矩形网格）
+    using Solver = SearchResult (PathFinder::*)(Maze&);
+    const Solver solvers[] = {
+        &PathFinder::findPathDFS,
+        &PathFinder::findPathBFS,
+        &PathFinder::findPathAStar,
+        &PathFinder::findPathBidirectionalBFS,
+        &PathFinder::findPathBidirectionalAStar,
+        &PathFinder::findPathJPS,
+        &PathFinder::findPathTree,
+    };
+    
+    for (Solver solver : solvers) {
+        SearchResult result = (this->*solver)(maze);
+        std::cout << std::setw(15) << result.algorithm
+                  << std::setw(10) << (result.found ? "是" : "否")
+                  << std::setw(10) << result.steps
+                  << std::setw(12) << result.visitedNodes
+                  << std::setw(12) << std::fixed << std::setprecision(3) << result.searchTime
+                  << std::endl;
+    }
     
     std::cout << std::endl;
 }
@@ -345,3 +515,11 @@ void PathFinder::printSearchResult(const SearchResult& result) {
     }
     std::cout << std::endl;
 }
+
+// 带观察者的搜索入口的显式实例化（模板定义只在本文件中）
+template PathFinder::SearchResult PathFinder::findPathDFS<NullSearchObserver>(Maze&, NullSearchObserver&);
+template PathFinder::SearchResult PathFinder::findPathDFS<SearchTrace>(Maze&, SearchTrace&);
+template PathFinder::SearchResult PathFinder::findPathBFS<NullSearchObserver>(Maze&, NullSearchObserver&);
+template PathFinder::SearchResult PathFinder::findPathBFS<SearchTrace>(Maze&, SearchTrace&);
+template PathFinder::SearchResult PathFinder::findPathAStar<NullSearchObserver>(Maze&, NullSearchObserver&);
+template PathFinder::SearchResult PathFinder::findPathAStar<SearchTrace>(Maze&, SearchTrace&);
@@ -0,0 +1,162 @@
+#include "reachability.h"
+#include <algorithm>
+
+/**
+ * 可达性引擎的实现
+ * 位为1表示有墙（见maze_storage.h），因此连通掩码都是墙壁位取反后再去掉行尾填充位
+ */
+
+ReachabilityEngine::ReachabilityEngine(const Maze& maze, bool useBitRows)
+    : maze(maze), bitRows(useBitRows && maze.isRectangularGrid()),
+      rows(maze.getRows()), cols(maze.getCols()),
+      words(maze.getStorage().getWordsPerRow()),
+      lastWordMask((cols & 63) ? (std::uint64_t(1) << (cols & 63)) - 1 : ~std::uint64_t(0)) {
+    if (bitRows) {
+        reach.assign(static_cast<std::size_t>(rows) * words, 0);
+        queued.assign(reach.size(), 0);
+    } else {
+        filled.assign(maze.getCellCount(), 0);
+    }
+}
+
+void ReachabilityEngine::clear() {
+    std::fill(reach.begin(), reach.end(), 0);
+    std::fill(filled.begin(), filled.end(), 0);
+}
+
+std::size_t ReachabilityEngine::floodFill(const Point& start) {
+    clear();
+    return fillFrom(start);
+}
+
+bool ReachabilityEngine::isFilled(const Point& p) const {
+    if (!maze.isValidPosition(p)) return false;
+    if (!bitRows) return filled[maze.toIndex(p)] != 0;
+    return (reach[static_cast<std::size_t>(p.x) * words + (p.y >> 6)] >> (p.y & 63)) & 1;
+}
+
+bool ReachabilityEngine::isReachable(const Point& from, const Point& to) {
+    if (!maze.isValidPosition(from) || !maze.isValidPosition(to)) return false;
+    floodFill(from);
+    return isFilled(to);
+}
+
+std::vector<std::size_t> ReachabilityEngine::componentSizes() {
+    clear();
+    std::vector<std::size_t> sizes;
+    if (!bitRows) {
+        int cellCount = maze.getCellCount();
+        for (int c = 0; c < cellCount; c++) {
+            if (!filled[c]) sizes.push_back(fillCells(c));
+        }
+        return sizes;
+    }
+
+    // 各连通分量互不相连，在同一张位图上依次填充不会互相影响
+    for (int x = 0; x < rows; x++) {
+        const std::uint64_t* row = &reach[static_cast<std::size_t>(x) * words];
+        for (std::size_t w = 0; w < words; w++) {
+            std::uint64_t valid = (w + 1 == words) ? lastWordMask : ~std::uint64_t(0);
+            std::uint64_t missing;
+            while ((missing = ~row[w] & valid) != 0) {
+                int y = static_cast<int>(w * 64) + __builtin_ctzll(missing);
+                sizes.push_back(fillRows(x, y));
+            }
+        }
+    }
+    return sizes;
+}
+
+std::size_t ReachabilityEngine::fillFrom(const Point& start) {
+    if (!maze.isValidPosition(start) || isFilled(start)) return 0;
+    return bitRows ? fillRows(start.x, start.y) : fillCells(maze.toIndex(start));
+}
+
+std::size_t ReachabilityEngine::fillCells(int start) {
+    int adjacent[NeighborList::CAPACITY];
+    std::size_t count = 1;
+    filled[start] = 1;
+    stack.clear();
+    stack.push_back(start);
+    while (!stack.empty()) {
+        int cell = stack.back();
+        stack.pop_back();
+        int n = maze.getNeighborIndices(cell, adjacent);
+        for (int k = 0; k < n; k++) {
+            if (!filled[adjacent[k]]) {
+                filled[adjacent[k]] = 1;
+                count++;
+                stack.push_back(adjacent[k]);
+            }
+        }
+    }
+    return count;
+}
+
+std::size_t ReachabilityEngine::fillRows(int x, int y) {
+    // 以"字"为单位的工作栈：只有新填充的位能通过打开的墙影响到的字才入栈
+    std::size_t count = 1 + updateWord(x, static_cast<std::size_t>(y >> 6), std::uint64_t(1) << (y & 63));
+    while (!stack.empty()) {
+        std::size_t id = static_cast<std::size_t>(stack.back());
+        stack.pop_back();
+        queued[id] = 0;
+        count += updateWord(static_cast<int>(id / words), id % words, 0);
+    }
+    return count;
+}
+
+std::uint64_t ReachabilityEngine::linkRight(int x, std::size_t w) const {
+    std::uint64_t link = ~maze.getStorage().rightRow(x)[w];
+    if (w + 1 == words) {
+        // 最后一列的右墙是外边界（可能为入口/出口打开），不连接任何格子
+        link &= lastWordMask >> 1;
+    }
+    return link;
+}
+
+void ReachabilityEngine::enqueue(int x, std::size_t w) {
+    std::size_t id = static_cast<std::size_t>(x) * words + w;
+    if (!queued[id]) {
+        queued[id] = 1;
+        stack.push_back(static_cast<long long>(id));
+    }
+}
+
+std::size_t ReachabilityEngine::updateWord(int x, std::size_t w, std::uint64_t extra) {
+    const MazeStorage& storage = maze.getStorage();
+    std::uint64_t* word = &reach[static_cast<std::size_t>(x) * words + w];
+    const std::uint64_t old = *word;
+
+    // 种子：本字已有的位、上下两行通过打开的下墙传来的位、左右相邻字跨边界传来的位
+    std::uint64_t seeds = old | extra;
+    if (x > 0) seeds |= word[-static_cast<std::ptrdiff_t>(words)] & ~storage.bottomRow(x - 1)[w];
+    if (x < rows - 1) seeds |= word[words] & ~storage.bottomRow(x)[w];
+    std::uint64_t link = linkRight(x, w);
+    std::uint64_t leftLink = (w > 0) ? linkRight(x, w - 1) : 0;
+    if (w > 0 && (word[-1] >> 63) && (leftLink >> 63)) seeds |= 1;
+    if (w + 1 < words && (word[1] & 1) && (link >> 63)) seeds |= std::uint64_t(1) << 63;
+
+    // 向右：v中每段连续的1（与左邻格相连、尚未填充）若紧接在种子之后，
+    // 在该段最低位加1，进位恰好把整段翻转
+    std::uint64_t v = (link << 1) & ~seeds;
+    std::uint64_t start = (seeds << 1) & v;
+    seeds |= ((v + start) ^ v) & v;
+
+    // 向左：移位倍增，第k步后propagate的第y位表示从y+2^k能沿走廊一路走到y
+    std::uint64_t propagate = link;
+    for (int shift = 1; shift < 64; shift <<= 1) {
+        seeds |= propagate & (seeds >> shift);
+        propagate &= propagate >> shift;
+    }
+
+    std::uint64_t added = seeds & ~old;
+    if (!added) return 0;
+    *word = seeds;
+
+    // 新填充的位能到达的相邻字才需要重新处理
+    if (x > 0 && (added & ~storage.bottomRow(x - 1)[w])) enqueue(x - 1, w);
+    if (x < rows - 1 && (added & ~storage.bottomRow(x)[w])) enqueue(x + 1, w);
+    if (w > 0 && (added & 1) && (leftLink >> 63)) enqueue(x, w - 1);
+    if (w + 1 < words && (added >> 63) && (link >> 63)) enqueue(x, w + 1);
+    return __builtin_popcountll(added) - ((extra & ~old) ? 1 : 0);
+}
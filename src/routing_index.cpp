@@ -0,0 +1,473 @@
+#include "routing_index.h"
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <queue>
+#include <algorithm>
+#include <functional>
+
+/**
+ * 路由索引的实现
+ * 构建分两步：先把迷宫收缩成"节点 + 走廊"图，再在该图上建立收缩层次
+ */
+
+namespace {
+
+// 见证搜索最多确定的节点数：超过后认为没有见证路径，多加一条捷径不影响正确性
+const int WITNESS_SETTLE_LIMIT = 256;
+
+struct BuildEdge {
+    int to;
+    int weight;
+    int middle;
+    int chain;
+};
+
+// 两个节点之间只保留最短的一条边
+void addOrImprove(std::vector<BuildEdge>& edges, const BuildEdge& edge) {
+    for (BuildEdge& e : edges) {
+        if (e.to == edge.to) {
+            if (edge.weight < e.weight) e = edge;
+            return;
+        }
+    }
+    edges.push_back(edge);
+}
+
+} // namespace
+
+RoutingIndex::RoutingIndex(const Maze& maze) : maze(maze), cellCount(maze.getCellCount()) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    buildCorridors();
+    buildHierarchy();
+
+    int nodeCount = getNodeCount();
+    for (SearchSpace* space : {&forward, &backward}) {
+        space->mark.assign(nodeCount, 0);
+        space->dist.resize(nodeCount);
+        space->parentEdge.resize(nodeCount);
+        space->parentNode.resize(nodeCount);
+        space->heap.reserveIds(nodeCount);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    buildTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+void RoutingIndex::buildCorridors() {
+    nodeOf.assign(cellCount, -1);
+    chainOf.assign(cellCount, -1);
+    chainPos.assign(cellCount, 0);
+    int adjacent[NeighborList::CAPACITY];
+
+    // 度数不为2的格子（岔路口、死胡同、孤立格子）是节点
+    for (int c = 0; c < cellCount; c++) {
+        if (maze.getNeighborIndices(c, adjacent) != 2) {
+            nodeOf[c] = static_cast<int>(nodeCell.size());
+            nodeCell.push_back(c);
+        }
+    }
+
+    // 从节点u出发、经过相邻格子first，沿走廊一直走到下一个节点
+    auto trace = [&](int u, int first) {
+        if (nodeOf[first] >= 0) {
+            // 两个节点直接相邻：长度为1、没有内部格子的走廊，只从编号较小的一端记录一次
+            if (nodeCell[u] < first) {
+                chains.push_back(Chain{u, nodeOf[first], 1, static_cast<int>(chainCells.size())});
+            }
+            return;
+        }
+        if (chainOf[first] >= 0) return;  // 已经从另一端记录过
+
+        int id = static_cast<int>(chains.size());
+        int begin = static_cast<int>(chainCells.size());
+        int prev = nodeCell[u];
+        int cur = first;
+        int pos = 1;
+        while (nodeOf[cur] < 0) {
+            chainOf[cur] = id;
+            chainPos[cur] = pos++;
+            chainCells.push_back(cur);
+            maze.getNeighborIndices(cur, adjacent);
+            int next = (adjacent[0] == prev) ? adjacent[1] : adjacent[0];
+            prev = cur;
+            cur = next;
+        }
+        chains.push_back(Chain{u, nodeOf[cur], pos, begin});
+    };
+
+    int initialNodes = getNodeCount();
+    for (int u = 0; u < initialNodes; u++) {
+        int count = maze.getNeighborIndices(nodeCell[u], adjacent);
+        int around[NeighborList::CAPACITY];
+        std::copy(adjacent, adjacent + count, around);
+        for (int k = 0; k < count; k++) {
+            trace(u, around[k]);
+        }
+    }
+
+    // 剩下的格子组成不含节点的环：任选一个格子提升为节点
+    for (int c = 0; c < cellCount; c++) {
+        if (nodeOf[c] >= 0 || chainOf[c] >= 0) continue;
+        int u = static_cast<int>(nodeCell.size());
+        nodeOf[c] = u;
+        nodeCell.push_back(c);
+        int count = maze.getNeighborIndices(c, adjacent);
+        int around[NeighborList::CAPACITY];
+        std::copy(adjacent, adjacent + count, around);
+        for (int k = 0; k < count; k++) {
+            trace(u, around[k]);
+        }
+    }
+}
+
+void RoutingIndex::buildHierarchy() {
+    int n = getNodeCount();
+    std::vector<std::vector<BuildEdge>> adj(n);
+    for (int id = 0; id < static_cast<int>(chains.size()); id++) {
+        const Chain& chain = chains[id];
+        if (chain.from == chain.to) continue;  // 自环不会出现在最短路径中
+        addOrImprove(adj[chain.from], BuildEdge{chain.to, chain.length, -1, id});
+        addOrImprove(adj[chain.to], BuildEdge{chain.from, chain.length, -1, id});
+    }
+
+    // 见证搜索：在去掉被收缩节点后的图中，从source出发做有界Dijkstra
+    std::vector<int> witnessDist(n);
+    std::vector<unsigned> witnessMark(n, 0);
+    unsigned witnessStamp = 0;
+    IndexedHeap witnessHeap;
+    witnessHeap.reserveIds(n);
+
+    auto witnessSearch = [&](int source, int excluded, int limit) {
+        if (++witnessStamp == 0) {
+            std::fill(witnessMark.begin(), witnessMark.end(), 0);
+            witnessStamp = 1;
+        }
+        witnessMark[source] = witnessStamp;
+        witnessDist[source] = 0;
+        witnessHeap.pushOrDecrease(source, 0);
+        int settled = 0;
+        while (!witnessHeap.empty()) {
+            int x = witnessHeap.pop();
+            if (witnessDist[x] > limit || ++settled > WITNESS_SETTLE_LIMIT) break;
+            for (const BuildEdge& e : adj[x]) {
+                if (e.to == excluded) continue;
+                int d = witnessDist[x] + e.weight;
+                if (d > limit) continue;
+                if (witnessMark[e.to] != witnessStamp) {
+                    witnessMark[e.to] = witnessStamp;
+                    witnessDist[e.to] = d;
+                    witnessHeap.pushOrDecrease(e.to, d);
+                } else if (d < witnessDist[e.to] && witnessHeap.contains(e.to)) {
+                    witnessDist[e.to] = d;
+                    witnessHeap.pushOrDecrease(e.to, d);
+                }
+            }
+        }
+        witnessHeap.clear();
+    };
+
+    // 收缩节点v需要的捷径数；apply为true时真正加入捷径并把v从图中移除
+    std::vector<int> deletedNeighbors(n, 0);
+    std::vector<int> level(n, 0);
+    std::vector<std::vector<UpEdge>> up(n);
+    auto contract = [&](int v, bool apply) {
+        const std::vector<BuildEdge> around = adj[v];
+        int maxWeight = 0;
+        for (const BuildEdge& e : around) maxWeight = std::max(maxWeight, e.weight);
+
+        int needed = 0;
+        for (std::size_t i = 0; i + 1 < around.size(); i++) {
+            int u = around[i].to;
+            witnessSearch(u, v, around[i].weight + maxWeight);
+            for (std::size_t j = i + 1; j < around.size(); j++) {
+                int w = around[j].to;
+                int via = around[i].weight + around[j].weight;
+                if (witnessMark[w] == witnessStamp && witnessDist[w] <= via) continue;
+                needed++;
+                if (apply) {
+                    addOrImprove(adj[u], BuildEdge{w, via, v, -1});
+                    addOrImprove(adj[w], BuildEdge{u, via, v, -1});
+                }
+            }
+        }
+
+        if (apply) {
+            // 此时仍与v相连的节点都比v晚收缩，这些边就是v向上的边
+            for (const BuildEdge& e : around) {
+                up[v].push_back(UpEdge{e.to, e.weight, e.middle, e.chain});
+                std::vector<BuildEdge>& back = adj[e.to];
+                back.erase(std::remove_if(back.begin(), back.end(),
+                    [v](const BuildEdge& b) { return b.to == v; }), back.end());
+                deletedNeighbors[e.to]++;
+                level[e.to] = std::max(level[e.to], level[v] + 1);
+            }
+            adj[v].clear();
+            adj[v].shrink_to_fit();
+        }
+        return needed;
+    };
+
+    // 优先级：2×边差（新增捷径 - 删去的边）+ 已收缩的邻居数 + 层级，惰性更新。
+    // 后两项让收缩在图中均匀铺开，避免在同一区域连续收缩导致捷径堆积
+    auto priority = [&](int v) {
+        int edgeDifference = contract(v, false) - static_cast<int>(adj[v].size());
+        return 2 * edgeDifference + deletedNeighbors[v] + level[v];
+    };
+    using Entry = std::pair<int, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> order;
+    for (int v = 0; v < n; v++) {
+        order.push(Entry(priority(v), v));
+    }
+    std::vector<char> contracted(n, 0);
+    while (!order.empty()) {
+        int v = order.top().second;
+        order.pop();
+        if (contracted[v]) continue;
+        int p = priority(v);
+        if (!order.empty() && p > order.top().first) {
+            order.push(Entry(p, v));
+            continue;
+        }
+        contract(v, true);
+        contracted[v] = 1;
+    }
+
+    upFirst.assign(n + 1, 0);
+    for (int v = 0; v < n; v++) {
+        upFirst[v + 1] = upFirst[v] + static_cast<int>(up[v].size());
+    }
+    upEdges.reserve(upFirst[n]);
+    shortcutCount = 0;
+    for (int v = 0; v < n; v++) {
+        for (const UpEdge& e : up[v]) {
+            upEdges.push_back(e);
+            if (e.middle >= 0) shortcutCount++;
+        }
+    }
+}
+
+int RoutingIndex::entryNodes(int cell, int* nodes, int* offsets) const {
+    if (nodeOf[cell] >= 0) {
+        nodes[0] = nodeOf[cell];
+        offsets[0] = 0;
+        return 1;
+    }
+    const Chain& chain = chains[chainOf[cell]];
+    nodes[0] = chain.from;
+    offsets[0] = chainPos[cell];
+    nodes[1] = chain.to;
+    offsets[1] = chain.length - chainPos[cell];
+    return 2;
+}
+
+void RoutingIndex::beginQuery() {
+    if (++currentMark == 0) {
+        std::fill(forward.mark.begin(), forward.mark.end(), 0);
+        std::fill(backward.mark.begin(), backward.mark.end(), 0);
+        currentMark = 1;
+    }
+}
+
+void RoutingIndex::relax(SearchSpace& space, int node, int dist, int parentNode, int parentEdge) {
+    if (space.mark[node] != currentMark) {
+        space.mark[node] = currentMark;
+    } else if (dist >= space.dist[node] || !space.heap.contains(node)) {
+        return;
+    }
+    space.dist[node] = dist;
+    space.parentNode[node] = parentNode;
+    space.parentEdge[node] = parentEdge;
+    space.heap.pushOrDecrease(node, dist);
+}
+
+int RoutingIndex::query(int source, int target, int& meet) {
+    beginQuery();
+    meet = -1;
+    int best = INT_MAX;
+
+    // 两个格子在同一条走廊内部时，沿走廊直接走是一条候选路径
+    if (nodeOf[source] < 0 && nodeOf[target] < 0 && chainOf[source] == chainOf[target]) {
+        best = std::abs(chainPos[source] - chainPos[target]);
+    }
+
+    auto reached = [&](SearchSpace& space, SearchSpace& other, int node) {
+        if (other.mark[node] == currentMark && space.dist[node] + other.dist[node] < best) {
+            best = space.dist[node] + other.dist[node];
+            meet = node;
+        }
+    };
+
+    int nodes[2], offsets[2];
+    int count = entryNodes(source, nodes, offsets);
+    for (int k = 0; k < count; k++) {
+        relax(forward, nodes[k], offsets[k], -1, -1);
+    }
+    count = entryNodes(target, nodes, offsets);
+    for (int k = 0; k < count; k++) {
+        relax(backward, nodes[k], offsets[k], -1, -1);
+        reached(backward, forward, nodes[k]);
+    }
+
+    // 两侧都只沿向上的边搜索；一侧的最小距离不小于best时该侧停止
+    while (true) {
+        bool forwardActive = !forward.heap.empty() && forward.heap.topKey() < best;
+        bool backwardActive = !backward.heap.empty() && backward.heap.topKey() < best;
+        if (!forwardActive && !backwardActive) break;
+
+        bool useForward = forwardActive &&
+            (!backwardActive || forward.heap.topKey() <= backward.heap.topKey());
+        SearchSpace& space = useForward ? forward : backward;
+        SearchSpace& other = useForward ? backward : forward;
+
+        int x = space.heap.pop();
+        if (stalled(space, x)) continue;
+        for (int e = upFirst[x]; e < upFirst[x + 1]; e++) {
+            int y = upEdges[e].to;
+            relax(space, y, space.dist[x] + upEdges[e].weight, x, e);
+            reached(space, other, y);
+        }
+    }
+
+    forward.heap.clear();
+    backward.heap.clear();
+    return best == INT_MAX ? -1 : best;
+}
+
+bool RoutingIndex::stalled(const SearchSpace& space, int x) const {
+    // 按需停滞（stall-on-demand）：如果某个更高层的邻居y已经给出更短的距离，
+    // 说明x的距离不是最短，x向上的边不必再扩展（y会负责这部分搜索）
+    for (int e = upFirst[x]; e < upFirst[x + 1]; e++) {
+        int y = upEdges[e].to;
+        if (space.mark[y] == currentMark && space.dist[y] + upEdges[e].weight < space.dist[x]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int RoutingIndex::distance(const Point& a, const Point& b) {
+    if (!maze.isValidPosition(a) || !maze.isValidPosition(b)) return -1;
+    int source = maze.toIndex(a);
+    int target = maze.toIndex(b);
+    if (source == target) return 0;
+    int meet;
+    return query(source, target, meet);
+}
+
+std::vector<Point> RoutingIndex::shortestPath(const Point& a, const Point& b) {
+    std::vector<Point> path;
+    if (!maze.isValidPosition(a) || !maze.isValidPosition(b)) return path;
+
+    int source = maze.toIndex(a);
+    int target = maze.toIndex(b);
+    if (source == target) {
+        path.push_back(a);
+        return path;
+    }
+
+    int meet;
+    int length = query(source, target, meet);
+    if (length < 0) return path;
+
+    std::vector<int> cells;
+    cells.reserve(length + 1);
+    cells.push_back(source);
+
+    if (meet < 0) {
+        appendChainCells(chainOf[source], chainPos[source], chainPos[target], cells);
+    } else {
+        // 正向：从相遇节点沿父指针回到起点一侧的入口节点
+        std::vector<int> upward;
+        for (int x = meet; ; x = forward.parentNode[x]) {
+            upward.push_back(x);
+            if (forward.parentEdge[x] < 0) break;
+        }
+        std::reverse(upward.begin(), upward.end());
+
+        // 起点在走廊中时，先走到入口节点（入口节点的距离就是当初选用的那一侧的步数）
+        int entry = upward.front();
+        if (nodeOf[source] < 0) {
+            int c = chainOf[source];
+            bool towardFrom = chains[c].from == entry && chainPos[source] == forward.dist[entry];
+            appendChainCells(c, chainPos[source], towardFrom ? 0 : chains[c].length, cells);
+        }
+        for (std::size_t i = 0; i + 1 < upward.size(); i++) {
+            appendEdgeCells(upward[i], upward[i + 1], forward.parentEdge[upward[i + 1]], cells);
+        }
+
+        // 反向：从相遇节点沿反向父指针走到终点一侧的入口节点
+        int x = meet;
+        while (backward.parentEdge[x] >= 0) {
+            appendEdgeCells(x, backward.parentNode[x], backward.parentEdge[x], cells);
+            x = backward.parentNode[x];
+        }
+        if (nodeOf[target] < 0) {
+            int c = chainOf[target];
+            bool fromStart = chains[c].from == x && chainPos[target] == backward.dist[x];
+            appendChainCells(c, fromStart ? 0 : chains[c].length, chainPos[target], cells);
+        }
+    }
+
+    path.reserve(cells.size());
+    for (int c : cells) {
+        path.push_back(maze.fromIndex(c));
+    }
+    return path;
+}
+
+int RoutingIndex::findUpEdge(int lower, int higher) const {
+    for (int e = upFirst[lower]; e < upFirst[lower + 1]; e++) {
+        if (upEdges[e].to == higher) return e;
+    }
+    return -1;
+}
+
+int RoutingIndex::chainCellAt(int chain, int pos) const {
+    const Chain& c = chains[chain];
+    if (pos == 0) return nodeCell[c.from];
+    if (pos == c.length) return nodeCell[c.to];
+    return chainCells[c.cellBegin + pos - 1];
+}
+
+void RoutingIndex::appendChainCells(int chain, int fromPos, int toPos, std::vector<int>& out) const {
+    int step = (toPos > fromPos) ? 1 : -1;
+    for (int pos = fromPos; pos != toPos; ) {
+        pos += step;
+        out.push_back(chainCellAt(chain, pos));
+    }
+}
+
+void RoutingIndex::appendEdgeCells(int x, int y, int edge, std::vector<int>& out) const {
+    // 捷径可能层层嵌套，用显式栈展开，先处理前半段
+    struct Segment { int from, to, edge; };
+    std::vector<Segment> pending;
+    pending.push_back(Segment{x, y, edge});
+    while (!pending.empty()) {
+        Segment s = pending.back();
+        pending.pop_back();
+        const UpEdge& e = upEdges[s.edge];
+        if (e.middle < 0) {
+            const Chain& c = chains[e.chain];
+            bool along = (c.from == s.from);
+            appendChainCells(e.chain, along ? 0 : c.length, along ? c.length : 0, out);
+        } else {
+            int m = e.middle;
+            pending.push_back(Segment{m, s.to, findUpEdge(m, s.to)});
+            pending.push_back(Segment{s.from, m, findUpEdge(m, s.from)});
+        }
+    }
+}
+
+std::size_t RoutingIndex::memoryBytes() const {
+    std::size_t bytes = 0;
+    bytes += (nodeOf.size() + chainOf.size() + chainPos.size() + nodeCell.size() + chainCells.size()) * sizeof(int);
+    bytes += chains.size() * sizeof(Chain);
+    bytes += upFirst.size() * sizeof(int) + upEdges.size() * sizeof(UpEdge);
+    for (const SearchSpace* space : {&forward, &backward}) {
+        bytes += space->mark.size() * sizeof(unsigned);
+        bytes += (space->dist.size() + space->parentEdge.size() + space->parentNode.size()) * sizeof(int);
+    }
+    return bytes;
+}
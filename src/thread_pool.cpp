@@ -0,0 +1,137 @@
+#include "thread_pool.h"
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+/**
+ * 线程池的实现
+ */
+
+namespace {
+
+thread_local int workerIndex = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(int threadCount) : pending(0), stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = hardwareThreads();
+    }
+    // 调用者线程在parallelFor中也参与计算，因此只需额外创建 threadCount-1 个工作线程
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::hardwareThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<int>(n);
+}
+
+int ThreadPool::currentWorker() {
+    return workerIndex;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    if (workers.empty()) {
+        // 单线程时直接在调用者线程执行
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+        pending++;
+    }
+    taskReady.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this] { return pending == 0; });
+}
+
+void ThreadPool::workerLoop(int index) {
+    workerIndex = index;
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;  // stopping且没有剩余任务
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) allDone.notify_all();
+        }
+    }
+}
+
+namespace {
+
+// 一次parallelFor调用的共享状态；由shared_ptr持有，晚到的工作任务也能安全访问
+struct ParallelForState {
+    std::atomic<int> next{0};        // 下一个待领取块的起点
+    std::atomic<int> nextSlot{1};    // slot 0 留给调用者线程
+    std::mutex mutex;
+    std::condition_variable finished;
+    int active = 0;                  // 正在执行的工作任务数
+    bool closed = false;             // 调用者已做完全部块，之后启动的任务直接返回
+};
+
+} // namespace
+
+void ThreadPool::parallelFor(int n, const std::function<void(int, int, int)>& fn, int minChunk) {
+    if (n <= 0) return;
+    minChunk = std::max(1, minChunk);
+
+    int runners = std::min(size(), (n + minChunk - 1) / minChunk);
+    if (runners <= 1) {
+        fn(0, n, 0);
+        return;
+    }
+
+    // 每个执行者循环领取大小为minChunk的块，负载自动均衡
+    auto state = std::make_shared<ParallelForState>();
+    auto drain = [state, n, minChunk, &fn](int slot) {
+        int begin;
+        while ((begin = state->next.fetch_add(minChunk)) < n) {
+            fn(begin, std::min(n, begin + minChunk), slot);
+        }
+    };
+
+    for (int i = 1; i < runners; i++) {
+        submit([state, drain] {
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->closed) return;
+                state->active++;
+            }
+            drain(state->nextSlot.fetch_add(1));
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (--state->active == 0) state->finished.notify_all();
+        });
+    }
+
+    drain(0);
+
+    // 只等待已经开始执行的任务；尚未被调度的任务看到closed后立即返回，
+    // 因此在工作线程内部嵌套调用parallelFor也不会死锁
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->closed = true;
+    state->finished.wait(lock, [&state] { return state->active == 0; });
+}
@@ -0,0 +1,148 @@
+#include "tree_index.h"
+#include "maze.h"
+#include <algorithm>
+#include <climits>
+
+/**
+ * 树索引的构建与查询
+ * 构建是一次显式栈先序遍历（同时检查是否有环、是否连通），再对父格子的先序编号建立区间最小值结构
+ */
+
+TreeIndex::TreeIndex(const Maze& maze) {
+    int n = maze.getCellCount();
+    if (n <= 0) return;
+
+    parent.assign(n, -1);
+    depth.assign(n, -1);
+    tin.assign(n, -1);
+    order.reserve(n);
+
+    // 入栈时记录父格子和深度；遇到已经发现过、又不是父格子的邻居说明有环
+    int adjacent[NeighborList::CAPACITY];
+    std::vector<int> stack;
+    stack.push_back(0);
+    depth[0] = 0;
+    bool cyclic = false;
+    while (!stack.empty() && !cyclic) {
+        int v = stack.back();
+        stack.pop_back();
+        tin[v] = static_cast<int>(order.size());
+        order.push_back(v);
+
+        int count = maze.getNeighborIndices(v, adjacent);
+        for (int k = 0; k < count; k++) {
+            int w = adjacent[k];
+            if (w == parent[v]) continue;
+            if (depth[w] >= 0) {
+                cyclic = true;
+                break;
+            }
+            parent[w] = v;
+            depth[w] = depth[v] + 1;
+            stack.push_back(w);
+        }
+    }
+
+    if (cyclic || static_cast<int>(order.size()) != n) {
+        // 有环或不连通：不是树，释放已分配的数组
+        parent = std::vector<int>();
+        depth = std::vector<int>();
+        tin = std::vector<int>();
+        order = std::vector<int>();
+        return;
+    }
+
+    tree = true;
+    buildRangeMin();
+}
+
+void TreeIndex::buildRangeMin() {
+    int n = static_cast<int>(order.size());
+    key.resize(n);
+    key[0] = INT_MAX;  // 根没有父格子，查询区间也不会从0开始
+    for (int i = 1; i < n; i++) {
+        key[i] = tin[parent[order[i]]];
+    }
+
+    // 块内：维护从块首到i的单调递增栈，位掩码记录栈中元素相对块首的位置
+    stackMask.resize(n);
+    int stack[BLOCK];
+    for (int start = 0; start < n; start += BLOCK) {
+        int top = 0;
+        std::uint64_t mask = 0;
+        for (int i = start; i < std::min(n, start + BLOCK); i++) {
+            while (top > 0 && key[stack[top - 1]] >= key[i]) {
+                mask &= ~(1ULL << (stack[--top] - start));
+            }
+            stack[top++] = i;
+            mask |= 1ULL << (i - start);
+            stackMask[i] = mask;
+        }
+    }
+
+    // 块间：以块最小值为元素的稀疏表
+    blockCount = (n + BLOCK - 1) / BLOCK;
+    int levels = 1;
+    while ((1 << levels) <= blockCount) levels++;
+    blockMin.resize(static_cast<std::size_t>(levels) * blockCount);
+    for (int b = 0; b < blockCount; b++) {
+        blockMin[b] = *std::min_element(key.begin() + b * BLOCK, key.begin() + std::min(n, (b + 1) * BLOCK));
+    }
+    for (int k = 1; k < levels; k++) {
+        const int* prev = &blockMin[static_cast<std::size_t>(k - 1) * blockCount];
+        int* cur = &blockMin[static_cast<std::size_t>(k) * blockCount];
+        for (int b = 0; b + (1 << k) <= blockCount; b++) {
+            cur[b] = std::min(prev[b], prev[b + (1 << (k - 1))]);
+        }
+    }
+}
+
+int TreeIndex::blockRangeMin(int b1, int b2) const {
+    int k = 31 - __builtin_clz(static_cast<unsigned>(b2 - b1 + 1));
+    const int* level = &blockMin[static_cast<std::size_t>(k) * blockCount];
+    return std::min(level[b1], level[b2 - (1 << k) + 1]);
+}
+
+int TreeIndex::rangeMin(int l, int r) const {
+    int bl = l / BLOCK, br = r / BLOCK;
+    if (bl == br) {
+        // 栈中位置不小于l的最低一位就是[l, r]的最小值
+        std::uint64_t mask = stackMask[r] & (~0ULL << (l - bl * BLOCK));
+        return key[bl * BLOCK + __builtin_ctzll(mask)];
+    }
+    int result = std::min(rangeMin(l, bl * BLOCK + BLOCK - 1), rangeMin(br * BLOCK, r));
+    if (bl + 1 < br) {
+        result = std::min(result, blockRangeMin(bl + 1, br - 1));
+    }
+    return result;
+}
+
+int TreeIndex::lca(int a, int b) const {
+    if (a == b) return a;
+    int l = tin[a], r = tin[b];
+    if (l > r) std::swap(l, r);
+    return order[rangeMin(l + 1, r)];
+}
+
+std::vector<int> TreeIndex::path(int a, int b) const {
+    int top = lca(a, b);
+    std::vector<int> cells;
+    cells.reserve(depth[a] + depth[b] - 2 * depth[top] + 1);
+    for (int v = a; v != top; v = parent[v]) {
+        cells.push_back(v);
+    }
+    cells.push_back(top);
+    // b一侧从下往上收集，再反转接在后面
+    std::size_t middle = cells.size();
+    for (int v = b; v != top; v = parent[v]) {
+        cells.push_back(v);
+    }
+    std::reverse(cells.begin() + middle, cells.end());
+    return cells;
+}
+
+std::size_t TreeIndex::memoryBytes() const {
+    std::size_t bytes = (parent.size() + depth.size() + tin.size() + order.size() + key.size()) * sizeof(int);
+    bytes += stackMask.size() * sizeof(std::uint64_t) + blockMin.size() * sizeof(int);
+    return bytes;
+}
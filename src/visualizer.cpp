@@ -4,7 +4,6 @@
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
-#include <set>
 #include <thread>
 #include <chrono>
 #include <cstring>
@@ -12,8 +11,13 @@
 #include <fstream>
 #include <cmath>
 #include "mondrian_maze.h"
+#include "reachability.h"
+#include "file_sink.h"
 #include <unordered_set> // Added for unordered_set
-#include <map>
+#include <algorithm>
+#include <charconv>
+#include <unistd.h>
+#include <sys/ioctl.h>
 
 /**
  * 可视化器的实现 - 支持线段墙壁显示
@@ -52,59 +56,82 @@ void Visualizer::displayMaze(const Maze& maze) const {
 }
 
 void Visualizer::displayMazeWithLineWalls(const Maze& maze) const {
-    std::cout << "\n" << getColorCode(Colors::CYAN) << "迷宫结构（线段表示墙壁）：" 
+    // 矩形迷宫整帧画进缓冲区后一次输出；其他形状逐格打印
+    if (MazeRenderer::supports(maze)) {
+        renderer.setUseColors(useColors);
+        renderer.render(maze);
+        renderer.present(std::cout);
+        return;
+    }
+    writeLineWalls(maze, std::vector<Point>(), std::cout);
+}
+
+void Visualizer::writeLineWalls(const Maze& maze, const std::vector<Point>& path, std::ostream& out) const {
+    out << "\n" << getColorCode(Colors::CYAN) << "迷宫结构（线段表示墙壁）：" 
               << getColorCode(Colors::RESET) << "\n\n";
     
     int rows = maze.getRows();
     int cols = maze.getCols();
     
+    // 路径格子（不含入口和出口）按行优先的编号排序，逐格二分查找，不需要复制迷宫
+    std::vector<long long> pathCells;
+    for (const Point& p : path) {
+        if (p != maze.getEntrance() && p != maze.getExit()) {
+            pathCells.push_back(static_cast<long long>(p.x) * cols + p.y);
+        }
+    }
+    std::sort(pathCells.begin(), pathCells.end());
+    
     // 显示列标号
-    std::cout << "    ";
+    out << "    ";
     for (int j = 0; j < cols; j++) {
-        std::cout << std::setw(4) << j;
+        out << std::setw(4) << j;
     }
-    std::cout << "\n";
+    out << "\n";
     
     // 显示顶部边界
-    std::cout << "  ┌";
+    out << "  ┌";
     for (int j = 0; j < cols; j++) {
         if (maze.hasWall(0, j, WallDirection::TOP)) {
-            std::cout << "───";
+            out << "───";
         } else {
-            std::cout << "   ";
+            out << "   ";
         }
         if (j < cols - 1) {
-            std::cout << "┬";
+            out << "┬";
         }
     }
-    std::cout << "┐\n";
+    out << "┐\n";
     
     // 显示迷宫内容
     for (int i = 0; i < rows; i++) {
         // 显示行标号和左边界
-        std::cout << std::setw(2) << i << (maze.hasWall(i, 0, WallDirection::LEFT) ? "│" : " ");
+        out << std::setw(2) << i << (maze.hasWall(i, 0, WallDirection::LEFT) ? "│" : " ");
         
         for (int j = 0; j < cols; j++) {
             // 显示格子内容
-            std::string cellContent = getCellSymbol(maze.getCell(i, j));
-            std::cout << cellContent;
+            MazeCell cell = maze.getCell(i, j);
+            if (std::binary_search(pathCells.begin(), pathCells.end(), static_cast<long long>(i) * cols + j)) {
+                cell.type = CellType::VISITED;
+            }
+            out << getCellSymbol(cell);
             
             // 显示右边界
             if (j < cols - 1) {
                 if (maze.hasWall(i, j, WallDirection::RIGHT)) {
-                    std::cout << "│";
+                    out << "│";
                 } else {
-                    std::cout << " ";
+                    out << " ";
                 }
             }
         }
         
         // 显示最右边界
-        std::cout << (maze.hasWall(i, cols-1, WallDirection::RIGHT) ? "│" : " ") << "\n";
+        out << (maze.hasWall(i, cols-1, WallDirection::RIGHT) ? "│" : " ") << "\n";
         
         // 显示底部边界（除最后一行）
         if (i < rows - 1) {
-            std::cout << "  ";
+            out << "  ";
             
             // 左侧连接符
             bool hasLeftBottom = maze.hasWall(i, 0, WallDirection::BOTTOM);
@@ -113,13 +140,13 @@ void Visualizer::displayMazeWithLineWalls(const Maze& maze) const {
             bool hasNextLeftLeft = maze.hasWall(i+1, 0, WallDirection::LEFT);
             
             if ((hasLeftBottom || hasLeftTop) && (hasLeftLeft || hasNextLeftLeft)) {
-                std::cout << "├";
+                out << "├";
             } else if (hasLeftBottom || hasLeftTop) {
-                std::cout << "─";
+                out << "─";
             } else if (hasLeftLeft || hasNextLeftLeft) {
-                std::cout << "│";
+                out << "│";
             } else {
-                std::cout << " ";
+                out << " ";
             }
             
             // 中间的水平线和连接符
@@ -128,9 +155,9 @@ void Visualizer::displayMazeWithLineWalls(const Maze& maze) const {
                 bool hasBottom = maze.hasWall(i, j, WallDirection::BOTTOM);
                 bool hasTop = maze.hasWall(i+1, j, WallDirection::TOP);
                 if (hasBottom || hasTop) {
-                    std::cout << "───";
+                    out << "───";
                 } else {
-                    std::cout << "   ";
+                    out << "   ";
                 }
                 
                 // 连接符（除最后一列）
@@ -143,7 +170,7 @@ void Visualizer::displayMazeWithLineWalls(const Maze& maze) const {
                     
                     std::string connector = getConnector(hasCurrentBottom, hasRightBottom, 
                                                 hasCurrentRight, hasNextRight);
-                    std::cout << connector;
+                    out << connector;
                 }
             }
             
@@ -154,32 +181,32 @@ void Visualizer::displayMazeWithLineWalls(const Maze& maze) const {
             bool hasNextRightRight = maze.hasWall(i+1, cols-1, WallDirection::RIGHT);
             
             if ((hasRightBottom || hasRightTop) && (hasRightRight || hasNextRightRight)) {
-                std::cout << "┤";
+                out << "┤";
             } else if (hasRightBottom || hasRightTop) {
-                std::cout << "─";
+                out << "─";
             } else if (hasRightRight || hasNextRightRight) {
-                std::cout << "│";
+                out << "│";
             } else {
-                std::cout << " ";
+                out << " ";
             }
             
-            std::cout << "\n";
+            out << "\n";
         }
     }
     
     // 显示底部边界
-    std::cout << "  └";
+    out << "  └";
     for (int j = 0; j < cols; j++) {
         if (maze.hasWall(rows-1, j, WallDirection::BOTTOM)) {
-            std::cout << "───";
+            out << "───";
         } else {
-            std::cout << "   ";
+            out << "   ";
         }
         if (j < cols - 1) {
-            std::cout << "┴";
+            out << "┴";
         }
     }
-    std::cout << "┘\n\n";
+    out << "┘\n\n";
 }
 
 std::string Visualizer::getConnector(bool hasLeft, bool hasRight, bool hasTop, bool hasBottom) const {
@@ -237,27 +264,27 @@ std::string Visualizer::getCellSymbol(const MazeCell& cell) const {
 }
 
 void Visualizer::displayMazeWithPath(const Maze& maze, const std::vector<Point>& path) const {
-    Maze tempMaze = maze.clone();
-    
-    // 标记路径
-    for (const Point& p : path) {
-        if (p != maze.getEntrance() && p != maze.getExit()) {
-            tempMaze.setCellType(p, CellType::VISITED);
-        }
+    if (MazeRenderer::supports(maze)) {
+        // 路径作为叠加层画出，不需要复制迷宫
+        renderer.setUseColors(useColors);
+        renderer.render(maze, path);
+        renderer.present(std::cout);
+    } else {
+        writeLineWalls(maze, path, std::cout);
     }
-    
-    displayMazeWithLineWalls(tempMaze);
-    
-    // 显示路径信息
-    std::cout << getColorCode(Colors::CYAN) << "路径信息：" << getColorCode(Colors::RESET) << "\n";
-    std::cout << "路径长度: " << (path.empty() ? 0 : path.size() - 1) << " 步\n";
-    std::cout << "路径坐标: ";
+    writePathInfo(path, std::cout);
+}
+
+void Visualizer::writePathInfo(const std::vector<Point>& path, std::ostream& out) const {
+    out << getColorCode(Colors::CYAN) << "路径信息：" << getColorCode(Colors::RESET) << "\n";
+    out << "路径长度: " << (path.empty() ? 0 : path.size() - 1) << " 步\n";
+    out << "路径坐标: ";
     for (size_t i = 0; i < path.size(); i++) {
-        if (i > 0) std::cout << " → ";
-        std::cout << "(" << path[i].x << "," << path[i].y << ")";
-        if (i > 0 && i % 8 == 0) std::cout << "\n          ";
+        if (i > 0) out << " → ";
+        out << "(" << path[i].x << "," << path[i].y << ")";
+        if (i > 0 && i % 8 == 0) out << "\n          ";
     }
-    std::cout << "\n\n";
+    out << "\n\n";
 }
 
 void Visualizer::animatePathFinding(Maze& maze, const std::vector<Point>& searchOrder,
@@ -272,20 +299,24 @@ void Visualizer::animatePathFinding(Maze& maze, const std::vector<Point>& search
     // 重置迷宫
     maze.resetVisited();
     
-    // 逐步显示搜索过程
-    for (size_t i = 0; i < searchOrder.size(); i++) {
-        const Point& current = searchOrder[i];
-        
-        if (current != maze.getEntrance() && current != maze.getExit()) {
-            maze.setCellType(current, CellType::VISITED);
+    if (MazeRenderer::supports(maze) && isatty(STDOUT_FILENO)) {
+        animateIncrementally(maze, searchOrder);
+    } else {
+        // 逐步显示搜索过程（非矩形迷宫或不是终端时每步重画整个迷宫）
+        for (size_t i = 0; i < searchOrder.size(); i++) {
+            const Point& current = searchOrder[i];
+            
+            if (current != maze.getEntrance() && current != maze.getExit()) {
+                maze.setCellType(current, CellType::VISITED);
+            }
+            
+            clearScreen();
+            std::cout << getColorCode(Colors::CYAN) << "搜索进度: " << (i + 1) << "/" << searchOrder.size() 
+                      << getColorCode(Colors::RESET) << "\n";
+            displayMazeWithLineWalls(maze);
+            
+            std::this_thread::sleep_for(std::chrono::milliseconds(animationDelay));
         }
-        
-        clearScreen();
-        std::cout << getColorCode(Colors::CYAN) << "搜索进度: " << (i + 1) << "/" << searchOrder.size() 
-                  << getColorCode(Colors::RESET) << "\n";
-        displayMazeWithLineWalls(maze);
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(animationDelay));
     }
     
     // 显示最终路径
@@ -296,21 +327,157 @@ void Visualizer::animatePathFinding(Maze& maze, const std::vector<Point>& search
     displayMazeWithPath(maze, finalPath);
 }
 
-void Visualizer::exportToHTML(const Maze& maze, const std::vector<Point>& path, 
-                            const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "无法创建HTML文件: " << filename << std::endl;
-        return;
+void Visualizer::animateIncrementally(Maze& maze, const std::vector<Point>& searchOrder) const {
+    // 每个显示周期（animationDelay毫秒）画一批格子，总时长不超过MAX_ANIMATION_MS
+    const int MAX_ANIMATION_MS = 10000;
+    size_t total = searchOrder.size();
+    size_t ticks = std::min(total, static_cast<size_t>(std::max(1, MAX_ANIMATION_MS / std::max(1, animationDelay))));
+    size_t perTick = ticks == 0 ? 1 : (total + ticks - 1) / ticks;
+    
+    auto status = [&](size_t done) {
+        return getColorCode(Colors::CYAN) + "搜索进度: " + std::to_string(done) + "/" + std::to_string(total) +
+               getColorCode(Colors::RESET);
+    };
+    
+    int lines = 24, columns = 80;
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0) {
+        lines = size.ws_row;
+        columns = size.ws_col;
     }
     
-    file << generateHTMLHeader();
-    file << generateMazeHTML(maze, path);
-    file << generateHTMLFooter();
+    // 迷宫只完整画一次，之后只重画新访问的格子
+    renderer.setUseColors(useColors);
+    renderer.render(maze);
+    renderer.beginAnimation(status(0), lines, columns);
+    renderer.presentPatch(std::cout);
     
-    file.close();
-    std::cout << getColorCode(Colors::GREEN) << "迷宫已导出到HTML文件: " << filename 
-              << getColorCode(Colors::RESET) << std::endl;
+    std::vector<Point> changed;
+    changed.reserve(perTick);
+    for (size_t begin = 0; begin < total; begin += perTick) {
+        size_t end = std::min(total, begin + perTick);
+        changed.clear();
+        for (size_t i = begin; i < end; i++) {
+            const Point& current = searchOrder[i];
+            if (current != maze.getEntrance() && current != maze.getExit()) {
+                maze.setCellType(current, CellType::VISITED);
+                changed.push_back(current);
+            }
+        }
+        renderer.renderPatch(status(end), changed.data(), changed.size(), CellType::VISITED);
+        renderer.presentPatch(std::cout);
+        std::this_thread::sleep_for(std::chrono::milliseconds(animationDelay));
+    }
+    
+    renderer.endAnimation();
+    renderer.presentPatch(std::cout);
+}
+
+namespace {
+
+// 网格布局最多的格子数：每格一个div，更大的迷宫浏览器难以打开，自动改用SVG布局
+const int HTML_GRID_MAX_CELLS = 2500;
+
+bool testBit(const std::uint64_t* bits, int i) {
+    return (bits[i >> 6] >> (i & 63)) & 1;
+}
+
+void appendInt(std::string& out, int value) {
+    char buffer[16];
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+void appendMove(std::string& d, int x, int y, char direction, int length) {
+    d += 'M';
+    appendInt(d, x);
+    d += ' ';
+    appendInt(d, y);
+    d += direction;
+    appendInt(d, length);
+}
+
+// 把矩形迷宫的墙壁合并成尽量长的水平和竖直线段，写成SVG路径命令（M x y h 长度 / M x y v 长度），
+// 格子边长为unit。按行扫描墙壁位平面，竖直线段只记录每条竖线上正在延伸的起始行，
+// 每扫完一行就把这一行产生的命令写出去，额外内存O(列数)
+void writeWallRuns(const Maze& maze, int unit, std::ostream& out) {
+    const MazeStorage& storage = maze.getStorage();
+    int rows = maze.getRows();
+    int cols = maze.getCols();
+    std::string d;
+    
+    // 第y条水平线上的墙壁，wallAt(j)表示第j段是否有墙
+    auto scanLine = [&](int y, auto wallAt) {
+        int start = -1;
+        for (int j = 0; j <= cols; j++) {
+            bool wall = j < cols && wallAt(j);
+            if (wall && start < 0) {
+                start = j;
+            } else if (!wall && start >= 0) {
+                appendMove(d, start * unit, y * unit, 'h', (j - start) * unit);
+                start = -1;
+            }
+        }
+    };
+    
+    scanLine(0, [&](int j) { return storage.topBorder(j); });
+    std::vector<int> runStart(cols + 1, -1);   // 第x条竖线上正在延伸的线段的起始行，-1表示没有
+    for (int i = 0; i < rows; i++) {
+        const std::uint64_t* right = storage.rightRow(i);
+        for (int x = 0; x <= cols; x++) {
+            bool wall = x == 0 ? storage.leftBorder(i) : testBit(right, x - 1);
+            if (wall) {
+                if (runStart[x] < 0) runStart[x] = i;
+            } else if (runStart[x] >= 0) {
+                appendMove(d, x * unit, runStart[x] * unit, 'v', (i - runStart[x]) * unit);
+                runStart[x] = -1;
+            }
+        }
+        const std::uint64_t* bottom = storage.bottomRow(i);
+        scanLine(i + 1, [bottom](int j) { return testBit(bottom, j); });
+        out.write(d.data(), static_cast<std::streamsize>(d.size()));
+        d.clear();
+    }
+    for (int x = 0; x <= cols; x++) {
+        if (runStart[x] >= 0) appendMove(d, x * unit, runStart[x] * unit, 'v', (rows - runStart[x]) * unit);
+    }
+    out.write(d.data(), static_cast<std::streamsize>(d.size()));
+}
+
+} // namespace
+
+bool Visualizer::exportToHTML(const Maze& maze, const std::vector<Point>& path, 
+                            const std::string& filename, HtmlLayout layout) const {
+    FileSink file(filename);
+    if (!file.isOpen()) {
+        if (!quiet) std::cerr << "无法创建HTML文件: " << filename << std::endl;
+        return false;
+    }
+    std::ostream out(&file);
+    
+    if (layout == HTML_AUTO) {
+        layout = maze.getCellCount() > HTML_GRID_MAX_CELLS ? HTML_SVG : HTML_GRID;
+    }
+    if (layout == HTML_SVG && !maze.isRectangularGrid()) {
+        layout = HTML_GRID;
+    }
+    
+    // 逐行写入文件，不在内存中拼出整个文档
+    out << generateHTMLHeader();
+    if (layout == HTML_SVG) {
+        writeMazeSVG(maze, path, out);
+    } else {
+        writeMazeHTML(maze, path, out);
+    }
+    out << generateHTMLFooter();
+    
+    out.flush();
+    if (!file.close()) {
+        if (!quiet) std::cerr << "写入HTML文件失败: " << filename << std::endl;
+        return false;
+    }
+    if (!quiet) std::cout << getColorCode(Colors::GREEN) << "迷宫已导出到HTML文件: " << filename 
+                          << getColorCode(Colors::RESET) << std::endl;
+    return true;
 }
 
 std::string Visualizer::generateHTMLHeader() const {
@@ -385,23 +552,40 @@ std::string Visualizer::generateHTMLHeader() const {
 )";
 }
 
-std::string Visualizer::generateMazeHTML(const Maze& maze, const std::vector<Point>& path) const {
-    std::ostringstream html;
-    
+void Visualizer::writeMazeHTML(const Maze& maze, const std::vector<Point>& path, std::ostream& html) const {
     int rows = maze.getRows();
     int cols = maze.getCols();
     
-    // 创建路径标记集合
-    std::set<Point> pathSet;
+    // 路径标记：ARROW_ROTATIONS的下标表示箭头方向，END表示路径终点（没有下一个点）。
+    // 同一个格子以path中最后一次离开它的方向为准；标记按格子编号排序后随逐格输出依次取用，内存与路径长度成正比
+    static const char* const ARROW_ROTATIONS[] = {"90", "-90", "0", "180", "0"};
+    const signed char END = 5;
+    struct PathMark {
+        long long cell;
+        long long order;    // 同一格子的标记按order排序，取最后一个
+        signed char mark;
+    };
+    std::vector<PathMark> marks;
+    marks.reserve(path.size() * 2);
     for (const Point& p : path) {
-        pathSet.insert(p);
+        if (maze.isValidPosition(p)) marks.push_back({static_cast<long long>(p.x) * cols + p.y, -1, END});
     }
-    
-    // 计算每个点的下一个点方向
-    std::map<Point, Point> nextMap;
     for (size_t i = 1; i < path.size(); ++i) {
-        nextMap[path[i-1]] = path[i];
+        const Point& from = path[i - 1];
+        if (!maze.isValidPosition(from)) continue;
+        int dx = path[i].x - from.x;
+        int dy = path[i].y - from.y;
+        signed char direction = 4;
+        if (dx == 1 && dy == 0) direction = 0;
+        else if (dx == -1 && dy == 0) direction = 1;
+        else if (dx == 0 && dy == 1) direction = 2;
+        else if (dx == 0 && dy == -1) direction = 3;
+        marks.push_back({static_cast<long long>(from.x) * cols + from.y, static_cast<long long>(i), direction});
     }
+    std::sort(marks.begin(), marks.end(), [](const PathMark& a, const PathMark& b) {
+        return a.cell != b.cell ? a.cell < b.cell : a.order < b.order;
+    });
+    size_t nextMark = 0;
     
     html << "    <div class=\"maze-container\">\n";
     html << "        <div class=\"maze-grid\" style=\"grid-template-columns: repeat(" 
@@ -410,7 +594,11 @@ std::string Visualizer::generateMazeHTML(const Maze& maze, const std::vector<Poi
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
             const MazeCell& cell = maze.getCell(i, j);
-            Point currentPoint(i, j);
+            long long index = static_cast<long long>(i) * cols + j;
+            signed char direction = -1;
+            while (nextMark < marks.size() && marks[nextMark].cell == index) {
+                direction = marks[nextMark++].mark;
+            }
             
             html << "            <div class=\"maze-cell";
             
@@ -425,19 +613,10 @@ std::string Visualizer::generateMazeHTML(const Maze& maze, const std::vector<Poi
                 html << " cell-entrance\">S";
             } else if (cell.type == CellType::EXIT) {
                 html << " cell-exit\">E";
-            } else if (pathSet.count(currentPoint) > 0) {
+            } else if (direction >= 0) {
                 html << " cell-path\">";
-                auto it = nextMap.find(currentPoint);
-                if (it != nextMap.end()) {
-                    int dx = it->second.x - currentPoint.x;
-                    int dy = it->second.y - currentPoint.y;
-                    std::string rotate;
-                    if (dx == 1 && dy == 0) rotate = "90";
-                    else if (dx == -1 && dy == 0) rotate = "-90";
-                    else if (dx == 0 && dy == 1) rotate = "0";
-                    else if (dx == 0 && dy == -1) rotate = "180";
-                    else rotate = "0";
-                    html << "<svg class=\"arrow\" viewBox=\"0 0 24 24\" style=\"transform: rotate(" << rotate << "deg);\"><polygon points=\"6,4 18,12 6,20 8,12\" fill=\"#1976D2\"/></svg>";
+                if (direction != END) {
+                    html << "<svg class=\"arrow\" viewBox=\"0 0 24 24\" style=\"transform: rotate(" << ARROW_ROTATIONS[direction] << "deg);\"><polygon points=\"6,4 18,12 6,20 8,12\" fill=\"#1976D2\"/></svg>";
                 } else {
                     html << "<span style=\"font-size:20px;color:#1976D2;\">•</span>";
                 }
@@ -450,9 +629,14 @@ std::string Visualizer::generateMazeHTML(const Maze& maze, const std::vector<Poi
     }
     
     html << "        </div>\n";
+    writeInfoPanel(maze, path, html);
+    html << "    </div>\n";
+}
+
+void Visualizer::writeInfoPanel(const Maze& maze, const std::vector<Point>& path, std::ostream& html) const {
     html << "        <div class=\"info-panel\">\n";
     html << "            <h2>迷宫信息</h2>\n";
-    html << "            <p><strong>尺寸:</strong> " << rows << " × " << cols << "</p>\n";
+    html << "            <p><strong>尺寸:</strong> " << maze.getRows() << " × " << maze.getCols() << "</p>\n";
     html << "            <p><strong>入口:</strong> (" << maze.getEntrance().x << ", " 
          << maze.getEntrance().y << ")</p>\n";
     html << "            <p><strong>出口:</strong> (" << maze.getExit().x << ", " 
@@ -460,9 +644,70 @@ std::string Visualizer::generateMazeHTML(const Maze& maze, const std::vector<Poi
     html << "            <p><strong>路径长度:</strong> " << (path.empty() ? 0 : path.size() - 1) << " 步</p>\n";
     html << "            <p><strong>总墙壁数:</strong> " << maze.countWalls() << "</p>\n";
     html << "        </div>\n";
-    html << "    </div>\n";
+}
+
+void Visualizer::writeMazeSVG(const Maze& maze, const std::vector<Point>& path, std::ostream& out) const {
+    int rows = maze.getRows();
+    int cols = maze.getCols();
+    // 坐标单位：格子边长为2，墙壁在偶数坐标上、格子中心在奇数坐标上，全部是整数
+    int pixels = std::max(2, std::min(30, 1200 / std::max(rows, cols)));
+    
+    out << "    <div class=\"maze-container\">\n";
+    out << "        <svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << cols * pixels << "\" height=\"" << rows * pixels
+        << "\" viewBox=\"-1 -1 " << 2 * cols + 2 << " " << 2 * rows + 2
+        << "\" style=\"display:block;background-color:white;\">\n";
+    out << "            <defs><marker id=\"arrow\" viewBox=\"0 0 10 10\" refX=\"5\" refY=\"5\" markerWidth=\"4\" "
+           "markerHeight=\"4\" orient=\"auto\"><path d=\"M0 0L10 5L0 10z\" fill=\"#1976D2\"/></marker></defs>\n";
+    
+    auto cellRect = [&](const Point& p, const char* color) {
+        out << "            <rect x=\"" << 2 * p.y << "\" y=\"" << 2 * p.x << "\" width=\"2\" height=\"2\" fill=\""
+            << color << "\"/>\n";
+    };
+    if (maze.isValidPosition(maze.getEntrance())) cellRect(maze.getEntrance(), "#4CAF50");
+    if (maze.isValidPosition(maze.getExit())) cellRect(maze.getExit(), "#F44336");
     
-    return html.str();
+    // 路径：只保留拐点，黄色底线上叠加带箭头的蓝色细线；两条线各自重新遍历path写出坐标
+    auto writePoints = [&]() {
+        std::string points;
+        const Point* previous = nullptr;
+        for (size_t i = 0; i < path.size(); i++) {
+            const Point& p = path[i];
+            if (!maze.isValidPosition(p)) continue;
+            if (previous && i + 1 < path.size()) {
+                const Point& next = path[i + 1];
+                if (p.x - previous->x == next.x - p.x && p.y - previous->y == next.y - p.y) {
+                    previous = &p;
+                    continue;
+                }
+            }
+            appendInt(points, 2 * p.y + 1);
+            points += ',';
+            appendInt(points, 2 * p.x + 1);
+            points += ' ';
+            previous = &p;
+            if (points.size() >= 4096) {
+                out.write(points.data(), static_cast<std::streamsize>(points.size()));
+                points.clear();
+            }
+        }
+        out.write(points.data(), static_cast<std::streamsize>(points.size()));
+    };
+    bool hasPath = std::any_of(path.begin(), path.end(), [&maze](const Point& p) { return maze.isValidPosition(p); });
+    if (hasPath) {
+        out << "            <polyline points=\"";
+        writePoints();
+        out << "\" fill=\"none\" stroke=\"#FFEB3B\" stroke-width=\"1.4\" stroke-linecap=\"round\" stroke-linejoin=\"round\"/>\n";
+        out << "            <polyline points=\"";
+        writePoints();
+        out << "\" fill=\"none\" stroke=\"#1976D2\" stroke-width=\"0.3\" stroke-linejoin=\"round\" marker-end=\"url(#arrow)\"/>\n";
+    }
+    
+    out << "            <path fill=\"none\" stroke=\"#333\" stroke-width=\"0.3\" stroke-linecap=\"square\" d=\"";
+    writeWallRuns(maze, 2, out);
+    out << "\"/>\n";
+    out << "        </svg>\n";
+    writeInfoPanel(maze, path, out);
+    out << "    </div>\n";
 }
 
 std::string Visualizer::generateHTMLFooter() const {
@@ -470,35 +715,101 @@ std::string Visualizer::generateHTMLFooter() const {
 </html>)";
 }
 
-void Visualizer::exportToText(const Maze& maze, const std::vector<Point>& path, 
+bool Visualizer::exportToText(const Maze& maze, const std::vector<Point>& path, 
                             const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "无法创建文本文件: " << filename << std::endl;
-        return;
+    FileSink file(filename);
+    if (!file.isOpen()) {
+        if (!quiet) std::cerr << "无法创建文本文件: " << filename << std::endl;
+        return false;
     }
-    
-    // 重定向cout到文件
-    std::streambuf* oldCoutBuffer = std::cout.rdbuf();
-    std::cout.rdbuf(file.rdbuf());
+    std::ostream out(&file);
     
     // 输出迷宫信息
-    std::cout << "迷宫路径寻找结果\n";
-    std::cout << "================\n\n";
-    std::cout << "迷宫尺寸: " << maze.getRows() << " × " << maze.getCols() << "\n";
-    std::cout << "入口位置: (" << maze.getEntrance().x << ", " << maze.getEntrance().y << ")\n";
-    std::cout << "出口位置: (" << maze.getExit().x << ", " << maze.getExit().y << ")\n";
-    std::cout << "路径长度: " << (path.empty() ? 0 : path.size() - 1) << " 步\n\n";
+    out << "迷宫路径寻找结果\n";
+    out << "================\n\n";
+    out << "迷宫尺寸: " << maze.getRows() << " × " << maze.getCols() << "\n";
+    out << "入口位置: (" << maze.getEntrance().x << ", " << maze.getEntrance().y << ")\n";
+    out << "出口位置: (" << maze.getExit().x << ", " << maze.getExit().y << ")\n";
+    out << "路径长度: " << (path.empty() ? 0 : path.size() - 1) << " 步\n\n";
     
-    // 输出迷宫结构
-    displayMazeWithPath(maze, path);
+    // 输出迷宫结构：矩形迷宫逐行写出，内存只与列数和路径长度有关；
+    // 每次导出使用自己的渲染器，多个线程可以同时导出
+    if (MazeRenderer::supports(maze)) {
+        MazeRenderer textRenderer(MazeRenderer::Style::LABELED, useColors);
+        textRenderer.stream(maze, path, out);
+    } else {
+        writeLineWalls(maze, path, out);
+    }
+    writePathInfo(path, out);
     
-    // 恢复cout
-    std::cout.rdbuf(oldCoutBuffer);
-    file.close();
+    out.flush();
+    if (!file.close()) {
+        if (!quiet) std::cerr << "写入文本文件失败: " << filename << std::endl;
+        return false;
+    }
     
-    std::cout << getColorCode(Colors::GREEN) << "迷宫已导出到文本文件: " << filename 
-              << getColorCode(Colors::RESET) << std::endl;
+    if (!quiet) std::cout << getColorCode(Colors::GREEN) << "迷宫已导出到文本文件: " << filename 
+                          << getColorCode(Colors::RESET) << std::endl;
+    return true;
+}
+
+bool Visualizer::exportHeatmapToHTML(const Maze& maze, const SearchTrace& trace, const std::vector<Point>& path,
+                                     const std::string& filename) const {
+    if (!maze.isRectangularGrid() || trace.getCellCount() != maze.getCellCount()) {
+        if (!quiet) std::cerr << "搜索热力图只支持矩形迷宫，且轨迹必须来自同一个迷宫" << std::endl;
+        return false;
+    }
+    FileSink sink(filename);
+    if (!sink.isOpen()) {
+        if (!quiet) std::cerr << "无法创建HTML文件: " << filename << std::endl;
+        return false;
+    }
+    std::ostream file(&sink);
+    
+    int rows = maze.getRows();
+    int cols = maze.getCols();
+    int cell = std::max(2, std::min(24, 800 / std::max(rows, cols)));
+    int lastStep = std::max(1, trace.getStepCount());
+    
+    file << "<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title>搜索热力图</title>"
+            "<style>body{font-family:Arial,sans-serif;background:#f0f0f0;text-align:center;}</style></head><body>\n";
+    file << "<h1>搜索热力图</h1>\n";
+    file << "<p>扩展 " << trace.getStepCount() << " 步，最大前沿 " << trace.getMaxFrontier()
+         << " 格；颜色表示发现时刻（蓝色最早，红色最晚）</p>\n";
+    file << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << cols * cell + 4 << "\" height=\"" << rows * cell + 4
+         << "\" style=\"background:white\"><g transform=\"translate(2,2)\">\n";
+    
+    // 已发现的格子：色相从240（蓝）到0（红）
+    for (int index = 0; index < rows * cols; index++) {
+        int step = trace.getDiscoveryStep(index);
+        if (step < 0) continue;
+        int hue = 240 - static_cast<int>(240LL * step / lastStep);
+        file << "<rect x=\"" << (index % cols) * cell << "\" y=\"" << (index / cols) * cell << "\" width=\"" << cell
+             << "\" height=\"" << cell << "\" fill=\"hsl(" << hue << ",80%,60%)\"/>\n";
+    }
+    
+    // 墙壁：合并成连续线段后放进一条path
+    file << "<path fill=\"none\" stroke=\"#333\" stroke-width=\"" << std::max(1, cell / 8) << "\" d=\"";
+    writeWallRuns(maze, cell, file);
+    file << "\"/>\n";
+    
+    if (!path.empty()) {
+        file << "<polyline fill=\"none\" stroke=\"#222\" stroke-width=\"" << std::max(1, cell / 4) << "\" points=\"";
+        for (const Point& p : path) {
+            file << p.y * cell + cell / 2 << "," << p.x * cell + cell / 2 << " ";
+        }
+        file << "\"/>\n";
+    }
+    file << "</g></svg></body></html>\n";
+    file.flush();
+    if (!sink.close()) {
+        if (!quiet) std::cerr << "写入HTML文件失败: " << filename << std::endl;
+        return false;
+    }
+    
+    if (!quiet) std::cout << getColorCode(Colors::GREEN) << "搜索热力图已导出到HTML文件: " << filename
+                          << getColorCode(Colors::RESET) << std::endl;
+    return true;
 }
 
 void Visualizer::printStatistics(const Maze& maze) const {
@@ -509,6 +820,10 @@ void Visualizer::printStatistics(const Maze& maze) const {
     std::cout << "开放通道: " << maze.countOpenPaths() << "\n";
     std::cout << "连通性: " << std::fixed << std::setprecision(1) 
               << maze.getConnectivity() * 100 << "%\n";
+    std::vector<std::size_t> components = ReachabilityEngine(maze).componentSizes();
+    std::cout << "连通分量: " << components.size() << " 个，最大 "
+              << (components.empty() ? 0 : *std::max_element(components.begin(), components.end())) << " 格\n";
+    std::cout << "出口可达: " << (maze.isExitReachable() ? "是" : "否") << "\n";
     std::cout << "入口位置: (" << maze.getEntrance().x << ", " << maze.getEntrance().y << ")\n";
     std::cout << "出口位置: (" << maze.getExit().x << ", " << maze.getExit().y << ")\n\n";
 }
@@ -650,12 +965,12 @@ Point polarToCartesian(double radius, double angle_rad) {
     return {(int)(radius * cos(angle_rad)), (int)(radius * sin(angle_rad))};
 }
 
-void Visualizer::exportCircularToHTML(const CircularMaze& maze, const std::vector<Point>& path,
+bool Visualizer::exportCircularToHTML(const CircularMaze& maze, const std::vector<Point>& path,
                                       const std::string& filename) const {
     std::ofstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "无法创建HTML文件: " << filename << std::endl;
-        return;
+        if (!quiet) std::cerr << "无法创建HTML文件: " << filename << std::endl;
+        return false;
     }
 
     file << "<!DOCTYPE html><html><head><title>Circular Maze</title><style>body{text-align:center;}</style></head><body>";
@@ -714,14 +1029,19 @@ void Visualizer::exportCircularToHTML(const CircularMaze& maze, const std::vecto
 
     file << "</svg></body></html>";
     file.close();
-    std::cout << "圆形迷宫已导出到HTML文件: " << filename << std::endl;
+    if (!file) {
+        if (!quiet) std::cerr << "写入HTML文件失败: " << filename << std::endl;
+        return false;
+    }
+    if (!quiet) std::cout << "圆形迷宫已导出到HTML文件: " << filename << std::endl;
+    return true;
 }
 
-void Visualizer::exportMondrianToHTML(const MondrianMaze& maze, const std::vector<int>& path, const std::string& filename) const {
+bool Visualizer::exportMondrianToHTML(const MondrianMaze& maze, const std::vector<int>& path, const std::string& filename) const {
     std::ofstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "无法创建HTML文件: " << filename << std::endl;
-        return;
+        if (!quiet) std::cerr << "无法创建HTML文件: " << filename << std::endl;
+        return false;
     }
     file << "<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title>Mondrian Maze</title>"
             "<style>body{display:flex;flex-direction:column;align-items:center;justify-content:center;min-height:100vh;margin:0;}"
@@ -763,14 +1083,19 @@ void Visualizer::exportMondrianToHTML(const MondrianMaze& maze, const std::vecto
     file << "<p>绿色圆点为入口，橙色圆点为出口，红色粗线为路径。</p>\n";
     file << "</div></body></html>\n";
     file.close();
-    std::cout << "蒙德里安迷宫已导出到HTML文件: " << filename << std::endl;
+    if (!file) {
+        if (!quiet) std::cerr << "写入HTML文件失败: " << filename << std::endl;
+        return false;
+    }
+    if (!quiet) std::cout << "蒙德里安迷宫已导出到HTML文件: " << filename << std::endl;
+    return true;
 }
 
-void Visualizer::exportMondrianMultiPathsToHTML(const MondrianMaze& maze, const std::vector<std::vector<int>>& paths, int shortestIdx, const std::string& filename) const {
+bool Visualizer::exportMondrianMultiPathsToHTML(const MondrianMaze& maze, const std::vector<std::vector<int>>& paths, int shortestIdx, const std::string& filename) const {
     std::ofstream file(filename);
     if (!file.is_open()) {
-        std::cerr << "无法创建HTML文件: " << filename << std::endl;
-        return;
+        if (!quiet) std::cerr << "无法创建HTML文件: " << filename << std::endl;
+        return false;
     }
     file << "<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title>Mondrian Maze 多路径</title>"
             "<style>body{display:flex;flex-direction:column;align-items:center;justify-content:center;min-height:100vh;margin:0;}"
@@ -815,5 +1140,10 @@ void Visualizer::exportMondrianMultiPathsToHTML(const MondrianMaze& maze, const
     file << "<p>每张图绿色路径为该解法，绿色/橙色圆点为入口/出口。</p>\n";
     file << "</body></html>\n";
     file.close();
-    std::cout << "多路径 Mondrian 迷宫已导出到HTML文件: " << filename << std::endl;
+    if (!file) {
+        if (!quiet) std::cerr << "写入HTML文件失败: " << filename << std::endl;
+        return false;
+    }
+    if (!quiet) std::cout << "多路径 Mondrian 迷宫已导出到HTML文件: " << filename << std::endl;
+    return true;
 }
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * 作业服务器的压测客户端（make load_client）
+ * 功能：
+ * 1. 打开若干个连接，每个连接保持固定数量的在途请求（流水线发送，结果可以乱序返回）
+ * 2. 按id把每个结果与发送时间对应起来，统计吞吐量和延迟分布（p50/p90/p99/p99.9/最大值）
+ * 3. --seeds N 让种子在1..N之间循环，可以观察服务器复用已生成迷宫的效果；0表示每个请求使用不同的种子
+ * 用法：load_client [--socket 路径] [--requests N] [--connections N] [--window N] [--seeds N] [--job 字段]
+ * 先启动服务器：maze_solver --serve --socket 路径
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string socketPath = "maze_server.sock";
+    int requests = 10000;
+    int connections = 4;
+    int window = 32;            // 每个连接的在途请求数
+    int seeds = 0;
+    std::string job = "\"op\":\"solve\",\"type\":\"rect\",\"size\":\"100x100\",\"solvers\":[\"bfs\"]";
+};
+
+struct ConnectionStats {
+    std::vector<double> latencies;    // 毫秒
+    int failed = 0;
+    bool broken = false;
+};
+
+int connectTo(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) return -1;
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const std::string& text) {
+    std::size_t sent = 0;
+    while (sent < text.size()) {
+        ssize_t n = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+// 一个连接发送 [firstId, firstId + count) 号请求；sendTimes按id索引，各连接使用互不重叠的区间
+void runConnection(const Options& options, int firstId, int count, std::vector<Clock::time_point>& sendTimes,
+                   ConnectionStats& stats) {
+    int fd = connectTo(options.socketPath);
+    if (fd < 0) {
+        stats.broken = true;
+        return;
+    }
+
+    int sent = 0;
+    int received = 0;
+    std::string pending;
+    char buffer[1 << 16];
+    while (received < count) {
+        // 补满窗口：一次send发出多行
+        std::string batch;
+        while (sent < count && sent - received < options.window) {
+            int id = firstId + sent;
+            std::uint64_t seed = options.seeds > 0 ? static_cast<std::uint64_t>(id % options.seeds) + 1
+                                                   : static_cast<std::uint64_t>(id) + 1;
+            batch += "{\"id\":" + std::to_string(id) + ",\"seed\":" + std::to_string(seed) + "," + options.job + "}\n";
+            sendTimes[id] = Clock::now();
+            sent++;
+        }
+        if (!batch.empty() && !sendAll(fd, batch)) {
+            stats.broken = true;
+            break;
+        }
+
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            stats.broken = true;
+            break;
+        }
+        Clock::time_point now = Clock::now();
+        pending.append(buffer, static_cast<std::size_t>(n));
+        std::size_t start = 0, newline;
+        while ((newline = pending.find('\n', start)) != std::string::npos) {
+            std::string line = pending.substr(start, newline - start);
+            start = newline + 1;
+            received++;
+            std::size_t idPos = line.find("\"id\":");
+            int id = idPos == std::string::npos ? -1 : std::atoi(line.c_str() + idPos + 5);
+            if (line.find("\"ok\":true") == std::string::npos) stats.failed++;
+            if (id >= firstId && id < firstId + count) {
+                stats.latencies.push_back(std::chrono::duration<double, std::milli>(now - sendTimes[id]).count());
+            }
+        }
+        pending.erase(0, start);
+    }
+    close(fd);
+}
+
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    std::size_t index = static_cast<std::size_t>(std::ceil(q * sorted.size()));
+    return sorted[std::min(index == 0 ? 0 : index - 1, sorted.size() - 1)];
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "参数缺少取值: " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--socket") options.socketPath = value;
+        else if (arg == "--requests") options.requests = std::max(1, std::atoi(value.c_str()));
+        else if (arg == "--connections") options.connections = std::max(1, std::atoi(value.c_str()));
+        else if (arg == "--window") options.window = std::max(1, std::atoi(value.c_str()));
+        else if (arg == "--seeds") options.seeds = std::max(0, std::atoi(value.c_str()));
+        else if (arg == "--job") options.job = value;
+        else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: load_client [--socket 路径] [--requests N] [--connections N] [--window N] "
+                  << "[--seeds N] [--job 字段]" << std::endl;
+        return 1;
+    }
+
+    std::vector<Clock::time_point> sendTimes(options.requests);
+    std::vector<ConnectionStats> stats(options.connections);
+    std::vector<std::thread> threads;
+    Clock::time_point start = Clock::now();
+    int firstId = 0;
+    for (int c = 0; c < options.connections; c++) {
+        int count = options.requests / options.connections + (c < options.requests % options.connections ? 1 : 0);
+        threads.emplace_back(runConnection, std::cref(options), firstId, count, std::ref(sendTimes), std::ref(stats[c]));
+        firstId += count;
+    }
+    for (auto& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> latencies;
+    int failed = 0;
+    bool broken = false;
+    for (const auto& s : stats) {
+        latencies.insert(latencies.end(), s.latencies.begin(), s.latencies.end());
+        failed += s.failed;
+        broken = broken || s.broken;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    if (broken) std::cerr << "部分连接失败（服务器未启动或提前断开）: " << options.socketPath << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "请求: " << latencies.size() << "/" << options.requests << "  失败: " << failed
+              << "  连接: " << options.connections << "  窗口: " << options.window << "\n";
+    std::cout << "耗时: " << seconds << " s  吞吐: " << std::setprecision(1) << latencies.size() / seconds << " 请求/秒\n";
+    std::cout << std::setprecision(3) << "延迟(ms): p50=" << percentile(latencies, 0.5) << " p90=" << percentile(latencies, 0.9)
+              << " p99=" << percentile(latencies, 0.99) << " p99.9=" << percentile(latencies, 0.999)
+              << " max=" << (latencies.empty() ? 0.0 : latencies.back()) << std::endl;
+    return broken || failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,341 @@
+#include "maze.h"
+#include "CircularMaze.h"
+#include "mondrian_maze.h"
+#include "pathfinder.h"
+#include "visualizer.h"
+#include "maze_file.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/**
+ * 基准测试程序（make bench）- 非交互地扫描迷宫类型、规模、生成算法、求解算法和导出
+ * 功能：
+ * 1. 每个用例先预热，再重复计时，报告中位数、p99、每秒处理的格子数
+ * 2. 峰值常驻内存（每个用例开始前通过/proc/self/clear_refs清零，不支持时为进程峰值）
+ * 3. 计时期间的内存分配次数（替换全局operator new计数）
+ * 4. 输出CSV或JSON，便于在不同版本之间比较
+ * 用法：maze_bench [--format csv|json] [--max-cells N] [--trials N] [--warmup N]
+ *                  [--seed N] [--output 文件] [--filter 子串]
+ */
+
+namespace {
+
+std::atomic<std::uint64_t> allocationCount{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Options {
+    std::string format = "csv";
+    double maxCells = 1e6;
+    int trials = 5;
+    int warmup = 1;
+    std::uint64_t seed = 12345;
+    std::string output;
+    std::string filter;
+};
+
+struct Record {
+    std::string category;    // generate / solve / export
+    std::string mazeType;    // rect / circular / mondrian
+    std::string generator;
+    std::string operation;   // 生成算法、求解算法或导出格式
+    long long cells = 0;
+    int trials = 0;
+    double medianMs = 0;
+    double p99Ms = 0;
+    double cellsPerSec = 0;
+    long peakRssKb = 0;
+    double allocsPerTrial = 0;
+};
+
+// 清零峰值常驻内存（Linux 4.0+），失败时退化为进程启动以来的峰值
+void resetPeakRss() {
+    std::ofstream refs("/proc/self/clear_refs");
+    if (refs) refs << "5";
+}
+
+long peakRssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::atol(line.c_str() + 6);
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+double percentile(std::vector<double> samples, double q) {
+    std::sort(samples.begin(), samples.end());
+    std::size_t index = static_cast<std::size_t>(std::ceil(q * samples.size())) - 1;
+    return samples[std::min(index, samples.size() - 1)];
+}
+
+class Bench {
+public:
+    explicit Bench(const Options& options) : options(options) {}
+
+    // 运行一个用例：prepare在每次计时前执行（不计时），body是被测代码
+    void run(Record record, const std::function<void()>& prepare, const std::function<void()>& body) {
+        std::string name = record.category + "/" + record.mazeType + "/" + record.generator + "/" + record.operation;
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+
+        // 大规模用例每次都要几秒，减少重复次数
+        int trials = options.trials;
+        int warmup = options.warmup;
+        if (record.cells >= 10000000) {
+            trials = std::min(trials, 3);
+            warmup = 0;
+        }
+
+        resetPeakRss();
+        for (int i = 0; i < warmup; i++) {
+            prepare();
+            body();
+        }
+        std::vector<double> samples;
+        std::uint64_t allocations = 0;
+        for (int i = 0; i < trials; i++) {
+            prepare();
+            std::uint64_t before = allocationCount.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto end = std::chrono::steady_clock::now();
+            allocations += allocationCount.load(std::memory_order_relaxed) - before;
+            samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+
+        record.trials = trials;
+        record.medianMs = percentile(samples, 0.5);
+        record.p99Ms = percentile(samples, 0.99);
+        record.cellsPerSec = record.medianMs > 0 ? record.cells / (record.medianMs / 1000.0) : 0;
+        record.peakRssKb = peakRssKb();
+        record.allocsPerTrial = static_cast<double>(allocations) / trials;
+        records.push_back(record);
+        std::cerr << name << " cells=" << record.cells << " median=" << record.medianMs << "ms" << std::endl;
+    }
+
+    void write(std::ostream& out) const {
+        if (options.format == "json") {
+            out << "[\n";
+            for (std::size_t i = 0; i < records.size(); i++) {
+                const Record& r = records[i];
+                out << "  {\"category\": \"" << r.category << "\", \"maze\": \"" << r.mazeType
+                    << "\", \"generator\": \"" << r.generator << "\", \"operation\": \"" << r.operation
+                    << "\", \"cells\": " << r.cells << ", \"trials\": " << r.trials
+                    << ", \"median_ms\": " << r.medianMs << ", \"p99_ms\": " << r.p99Ms
+                    << ", \"cells_per_sec\": " << r.cellsPerSec << ", \"peak_rss_kb\": " << r.peakRssKb
+                    << ", \"allocs_per_trial\": " << r.allocsPerTrial << "}"
+                    << (i + 1 < records.size() ? "," : "") << "\n";
+            }
+            out << "]\n";
+            return;
+        }
+        out << "category,maze,generator,operation,cells,trials,median_ms,p99_ms,cells_per_sec,peak_rss_kb,allocs_per_trial\n";
+        for (const Record& r : records) {
+            out << r.category << "," << r.mazeType << "," << r.generator << "," << r.operation << ","
+                << r.cells << "," << r.trials << "," << r.medianMs << "," << r.p99Ms << ","
+                << r.cellsPerSec << "," << r.peakRssKb << "," << r.allocsPerTrial << "\n";
+        }
+    }
+
+private:
+    const Options& options;
+    std::vector<Record> records;
+};
+
+const char* generatorName(GenerationAlgorithm algorithm) {
+    switch (algorithm) {
+        case GenerationAlgorithm::KRUSKAL: return "kruskal";
+        case GenerationAlgorithm::ELLER:   return "eller";
+        default:                           return "dfs";
+    }
+}
+
+// 求解算法：名称和调用方式
+struct Solver {
+    const char* name;
+    std::function<PathFinder::SearchResult(PathFinder&, Maze&)> solve;
+};
+
+std::vector<Solver> solvers() {
+    return {
+        {"bfs", [](PathFinder& f, Maze& m) { return f.findPathBFS(m); }},
+        {"dfs", [](PathFinder& f, Maze& m) { return f.findPathDFS(m); }},
+        {"astar", [](PathFinder& f, Maze& m) { return f.findPathAStar(m); }},
+        {"bidirectional_bfs", [](PathFinder& f, Maze& m) { return f.findPathBidirectionalBFS(m); }},
+        {"bidirectional_astar", [](PathFinder& f, Maze& m) { return f.findPathBidirectionalAStar(m); }},
+        {"jps", [](PathFinder& f, Maze& m) { return f.findPathJPS(m); }},
+        {"tree", [](PathFinder& f, Maze& m) { return f.findPathTree(m); }},
+        {"parallel_bfs", [](PathFinder& f, Maze& m) { return f.findPathParallelBFS(m); }},
+    };
+}
+
+void benchRectangular(Bench& bench, const Options& options, int side) {
+    long long cells = static_cast<long long>(side) * side;
+    std::string size = std::to_string(side) + "x" + std::to_string(side);
+
+    // 生成
+    for (GenerationAlgorithm algorithm : {GenerationAlgorithm::DFS, GenerationAlgorithm::KRUSKAL, GenerationAlgorithm::ELLER}) {
+        Maze maze(side, side);
+        maze.setGenerationAlgorithm(algorithm);
+        bench.run({"generate", "rect", generatorName(algorithm), size, cells},
+                  [&] { maze.setSeed(options.seed); }, [&] { maze.generate(); });
+    }
+    {
+        Maze maze(side, side);
+        bench.run({"generate", "rect", "parallel", size, cells}, [] {},
+                  [&] { maze.generateParallel(options.seed); });
+        bench.run({"generate", "rect", "random_0.6", size, cells},
+                  [&] { maze.setSeed(options.seed); }, [&] { maze.generateRandomMaze(0.6); });
+    }
+
+    // 求解：完美迷宫（Kruskal）和有环的随机墙壁迷宫
+    for (const char* kind : {"kruskal", "random_0.6"}) {
+        Maze maze(side, side);
+        maze.setSeed(options.seed);
+        if (std::strcmp(kind, "kruskal") == 0) {
+            maze.setGenerationAlgorithm(GenerationAlgorithm::KRUSKAL);
+            maze.generate();
+        } else {
+            maze.generateRandomMaze(0.6);
+        }
+        PathFinder finder;
+        for (const Solver& solver : solvers()) {
+            bench.run({"solve", "rect", kind, solver.name, cells}, [] {},
+                      [&] { solver.solve(finder, maze); });
+        }
+    }
+
+    // 导出：二进制文件和SVG布局的HTML到所有规模；文本、网格布局的HTML只在小迷宫上测
+    Maze maze(side, side);
+    maze.setSeed(options.seed);
+    maze.generate();
+    std::string path = "/tmp/maze_bench_" + std::to_string(getpid());
+    bench.run({"export", "rect", "dfs", "binary", cells}, [] {},
+              [&] { MazeFile::save(maze, path + ".maze"); });
+    bench.run({"export", "rect", "dfs", "mmap_open", cells}, [] {},
+              [&] { MazeFile::map(path + ".maze"); });
+    Visualizer visualizer;
+    bench.run({"export", "rect", "dfs", "html_svg", cells}, [] {},
+              [&] { visualizer.exportToHTML(maze, {}, path + ".html", Visualizer::HTML_SVG); });
+    if (cells <= 250000) {
+        bench.run({"export", "rect", "dfs", "text", cells}, [] {},
+                  [&] { visualizer.exportToText(maze, {}, path + ".txt"); });
+        bench.run({"export", "rect", "dfs", "html", cells}, [] {},
+                  [&] { visualizer.exportToHTML(maze, {}, path + ".html", Visualizer::HTML_GRID); });
+        bench.run({"display", "rect", "dfs", "line_walls", cells}, [] {},
+                  [&] { visualizer.displayMaze(maze); });
+    }
+    std::remove((path + ".maze").c_str());
+    std::remove((path + ".txt").c_str());
+    std::remove((path + ".html").c_str());
+}
+
+void benchCircular(Bench& bench, const Options& options, double targetCells) {
+    // 第i环有6·2^i个格子，总数约为6·2^rings
+    int rings = std::max(3, static_cast<int>(std::lround(std::log2(targetCells / 6.0 + 1.0))));
+    CircularMaze maze(rings);
+    long long cells = maze.getCellCount();
+    std::string size = std::to_string(rings) + "rings";
+
+    bench.run({"generate", "circular", "dfs", size, cells},
+              [&] { maze.setSeed(options.seed); }, [&] { maze.generate(); });
+    PathFinder finder;
+    for (const Solver& solver : solvers()) {
+        bench.run({"solve", "circular", "dfs", solver.name, cells}, [] {},
+                  [&] { solver.solve(finder, maze); });
+    }
+}
+
+void benchMondrian(Bench& bench, const Options& options) {
+    std::uint64_t seed = options.seed;
+    MondrianMaze sample(seed);
+    long long rooms = sample.getRoomCount();
+    bench.run({"generate", "mondrian", "split", "800x800", rooms}, [] {},
+              [&] { MondrianMaze maze(seed); });
+    bench.run({"solve", "mondrian", "split", "bfs_min3", rooms}, [] {},
+              [&] { sample.findPath(sample.getEntranceId(), sample.getExitId(), 3); });
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "参数缺少取值: " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--format") options.format = value;
+        else if (arg == "--max-cells") options.maxCells = std::atof(value.c_str());
+        else if (arg == "--trials") options.trials = std::max(1, std::atoi(value.c_str()));
+        else if (arg == "--warmup") options.warmup = std::max(0, std::atoi(value.c_str()));
+        else if (arg == "--seed") options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--output") options.output = value;
+        else if (arg == "--filter") options.filter = value;
+        else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            return false;
+        }
+    }
+    if (options.format != "csv" && options.format != "json") {
+        std::cerr << "输出格式只能是csv或json" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "用法: maze_bench [--format csv|json] [--max-cells N] [--trials N] [--warmup N] "
+                  << "[--seed N] [--output 文件] [--filter 子串]" << std::endl;
+        return 1;
+    }
+
+    // 求解和导出的输出（路径、提示信息）不属于基准结果，屏蔽std::cout
+    std::ofstream discard("/dev/null");
+    std::streambuf* console = std::cout.rdbuf(discard.rdbuf());
+
+    Bench bench(options);
+    for (double cells = 1e2; cells <= options.maxCells * 1.0001; cells *= 100) {
+        benchRectangular(bench, options, static_cast<int>(std::lround(std::sqrt(cells))));
+        benchCircular(bench, options, cells);
+    }
+    benchMondrian(bench, options);
+
+    std::cout.rdbuf(console);
+    if (options.output.empty()) {
+        bench.write(std::cout);
+    } else {
+        std::ofstream out(options.output);
+        bench.write(out);
+    }
+    return 0;
+}